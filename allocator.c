@@ -0,0 +1,127 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: allocator.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 18:40:09 2026
+ * Version : 0.51
+ * ---
+ * Description: A pluggable memory allocator - used by all containers of the library -
+ *              written in ANSI C.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Added ALLOCATORset_thread() - an allocator per thread.
+ *
+ */
+
+/**
+ * @file allocator.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+
+/**
+ * Macro for declaring thread-local variables
+ *
+ * Where the compiler has no thread-local storage - the allocator of
+ * a thread is shared by all threads, like the one of the library.
+ **/
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define ALLOCATOR_TLS _Thread_local
+#elif defined(__GNUC__)
+#define ALLOCATOR_TLS __thread
+#elif defined(_MSC_VER)
+#define ALLOCATOR_TLS __declspec(thread)
+#else
+#define ALLOCATOR_TLS
+#endif
+
+/* STATIC FUNCTION DECLARATIONS */
+static void *std_alloc(void *ctx, size_t size);
+static void *std_realloc(void *ctx, void *ptr, size_t size);
+static void std_free(void *ctx, void *ptr);
+
+/* The allocator of the C library - the default */
+static const Allocator std_allocator = { std_alloc, std_realloc, std_free, NULL };
+
+/* The current allocator - of the library */
+static const Allocator *current = &std_allocator;
+
+/* The current allocator - of this thread, if set - overriding the one of the library */
+static ALLOCATOR_TLS const Allocator *thread_current = NULL;
+
+
+/* --- PUBLIC FUNCTION DEFINITIONS --- */
+/* --- Function: const Allocator *ALLOCATORset(const Allocator *alloc) --- */
+const Allocator *ALLOCATORset(const Allocator *alloc)
+{
+  const Allocator *prev = current;
+
+  current = alloc != NULL ? alloc : &std_allocator;
+
+  return prev;
+}
+
+/* --- Function: const Allocator *ALLOCATORset_thread(const Allocator *alloc) --- */
+const Allocator *ALLOCATORset_thread(const Allocator *alloc)
+{
+  const Allocator *prev = thread_current;
+
+  thread_current = alloc;
+
+  return prev;
+}
+
+/* --- Function: const Allocator *ALLOCATORget(void) --- */
+const Allocator *ALLOCATORget(void)
+{
+  return thread_current != NULL ? thread_current : current;
+}
+
+/* --- Function: void *ALLOCATORcalloc(const Allocator *alloc, size_t n, size_t size) --- */
+void *ALLOCATORcalloc(const Allocator *alloc, size_t n, size_t size)
+{
+  void *ptr;
+
+  if (alloc == &std_allocator)
+    return calloc(n, size);
+
+  /* Guard against overflow - like calloc() */
+  if (size > 0 && n > (size_t)-1 / size)
+    return NULL;
+
+  if ((ptr = ALLOCATOR_MALLOC(alloc, n * size)) != NULL)
+    memset(ptr, 0, n * size);
+
+  return ptr;
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static void *std_alloc(void *ctx, size_t size) --- */
+static void *std_alloc(void *ctx, size_t size)
+{
+  (void)ctx;
+  return malloc(size);
+}
+
+/* --- Function: static void *std_realloc(void *ctx, void *ptr, size_t size) --- */
+static void *std_realloc(void *ctx, void *ptr, size_t size)
+{
+  (void)ctx;
+  return realloc(ptr, size);
+}
+
+/* --- Function: static void std_free(void *ctx, void *ptr) --- */
+static void std_free(void *ctx, void *ptr)
+{
+  (void)ctx;
+  free(ptr);
+}
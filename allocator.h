@@ -0,0 +1,140 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: allocator.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 18:40:09 2026
+ * Version : 0.51
+ * ---
+ * Description: A pluggable memory allocator - used by all containers of the library -
+ *              written in ANSI C.
+ *
+ * Revision history - coming up below:
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Added ALLOCATORset_thread() - an allocator per thread.
+ *
+ */
+/**
+ * @file allocator.h
+ **/
+
+#ifndef _ALLOCATOR_H_
+#define _ALLOCATOR_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * An allocator - a table of user-defined memory functions
+   *
+   * Unlike the containers of the library, this @b struct is not
+   * hidden - since it is filled in by the user. All three functions
+   * must be set - and behave like @b malloc(), @b realloc() and
+   * @b free() - except that they get @a ctx as their 1st argument.
+   * @b realloc() is passed a NULL pointer - for new memory - never.
+   * An allocator backed by an arena - which frees all memory at once,
+   * when reset - may have a @a free that does nothing.
+   **/
+  typedef struct Allocator_
+  {
+    void *(*alloc)(void *ctx, size_t size);
+    void *(*realloc)(void *ctx, void *ptr, size_t size);
+    void (*free)(void *ctx, void *ptr);
+    void *ctx;     /* User context - e.g. a reference to an arena */
+  } Allocator;
+
+  /**
+   * Macros for allocating and freeing memory - through an allocator
+   *
+   * For use by the containers of the library - each of them keeps a
+   * reference @a a to the allocator, current when it was initiated.
+   **/
+#define ALLOCATOR_MALLOC(a, size) ((a)->alloc((a)->ctx, (size)))
+#define ALLOCATOR_REALLOC(a, ptr, size) ((ptr) != NULL ? (a)->realloc((a)->ctx, (ptr), (size)) : (a)->alloc((a)->ctx, (size)))
+#define ALLOCATOR_FREE(a, ptr) ((ptr) != NULL ? (a)->free((a)->ctx, (ptr)) : (void)0)
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Set the allocator of the library
+   *
+   * Every container - list, tree, heap, hash table, graph etc. - gets
+   * the allocator that is current when it is initiated - and uses it
+   * for all its memory, until it is destroyed. This function sets the
+   * allocator for the library as a whole - by a single call, before
+   * any container is initiated. Containers built on lists - hash
+   * tables and graphs - give their lists their own allocator, by
+   * @b SLISTinit_alloc().
+   * The allocator must outlive all containers using it. This
+   * function is not thread-safe - set the allocator before other
+   * threads start initiating containers. Use @b ALLOCATORset_thread()
+   * - for an allocator of a single thread, or a single container.
+   * @param[in] alloc - a reference to the allocator - or NULL, for
+   * the allocator of the C library - @b malloc(), @b realloc() and
+   * @b free().
+   * @return A reference to the allocator set before the call.
+   * @see ALLOCATORget()
+   **/
+  const Allocator *ALLOCATORset(const Allocator *alloc);
+
+  /**
+   * Set the allocator of the calling thread
+   *
+   * Overrides the allocator of the library - see @b ALLOCATORset() -
+   * for containers initiated by the calling thread, only. Other
+   * threads are not affected - so each thread may use an arena, or a
+   * memory pool of its own, e.g. on its own NUMA node. An allocator
+   * can be set for a single container, too - by setting it before the
+   * container is initiated, and setting the previous one back
+   * afterwards:
+   * @code
+   * const Allocator *prev = ALLOCATORset_thread(&arena_allocator);
+   * Slist list = SLISTinit(NULL);
+   * ALLOCATORset_thread(prev);
+   * @endcode
+   * A container keeps its allocator - and may be used, and destroyed,
+   * by other threads. On a compiler without thread-local storage, the
+   * allocator of the thread is shared by all threads - and this
+   * function is no more thread-safe than @b ALLOCATORset().
+   * @param[in] alloc - a reference to the allocator - or NULL, for
+   * the allocator of the library.
+   * @return A reference to the allocator of the thread, set before
+   * the call - or NULL, if none.
+   * @see ALLOCATORset(), ALLOCATORget()
+   **/
+  const Allocator *ALLOCATORset_thread(const Allocator *alloc);
+
+  /**
+   * Get the allocator of the library
+   *
+   * @return A reference to the current allocator - of the calling
+   * thread, if set, otherwise of the library - never NULL.
+   * @see ALLOCATORset(), ALLOCATORset_thread()
+   **/
+  const Allocator *ALLOCATORget(void);
+
+  /**
+   * Allocate zeroed memory - through an allocator
+   *
+   * Works like @b calloc().
+   * @param[in] alloc - a reference to the allocator.
+   * @param[in] n - the number of elements.
+   * @param[in] size - the size of each element, in bytes.
+   * @return A reference to the memory - or NULL, if out of memory.
+   **/
+  void *ALLOCATORcalloc(const Allocator *alloc, size_t n, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ALLOCATOR_H_ */
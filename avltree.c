@@ -13,6 +13,7 @@
  * 
  * Date   Revision message
  * 150331 This code ready for version 0.51
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
  */
 /**
  * @file avltree.c
@@ -23,6 +24,7 @@
 
 #include "utils.h"
 #include "avltree.h"
+#include "allocator.h"
 
 /**
  * Macro for level separation when calling AVLTREEprint()
@@ -49,6 +51,7 @@ struct AvlTree_
   int                   (*compare)(const void *key1, const void *key2);
   void                  (*destroy)(void *data);
   struct AvlTreeNode_   *root;
+  const Allocator       *alloc;
 };
 
 /* STATIC FUNCTION DECLARATIONS */
@@ -71,14 +74,16 @@ static int avltree_insright(AvlTree tree, AvlTreeNode node, const void *data);
 AvlTree AVLTREEinit(int (*compare)(const void *key1, const void *key2), void (*destroy)(void *data))
 {
   AvlTree tree;
+  const Allocator *alloc = ALLOCATORget();
 
-  if ((tree = (AvlTree)malloc(sizeof(struct AvlTree_)))==NULL)
+  if ((tree = (AvlTree)ALLOCATOR_MALLOC(alloc, sizeof(struct AvlTree_)))==NULL)
     return NULL;
 
   tree->size = 0;
   tree->compare = compare;
   tree->destroy = destroy;
   tree->root = NULL;
+  tree->alloc = alloc;
 
   return tree;
 }
@@ -86,7 +91,7 @@ AvlTree AVLTREEinit(int (*compare)(const void *key1, const void *key2), void (*d
 void AVLTREEdestroy(AvlTree tree)
 {
   destroy_left(tree, NULL);
-  free(tree);
+  ALLOCATOR_FREE(tree->alloc, tree);
 }
 
 int AVLTREEinsert(AvlTree tree, const void *data)
@@ -290,7 +295,7 @@ static void destroy_left(AvlTree tree, AvlTreeNode node)
           tree->destroy((*position)->data);
         }
       /* Now, free the node itself... */
-      free(*position);
+      ALLOCATOR_FREE(tree->alloc, *position);
       *position = NULL;
 
       /* Adjust the size of the tree to account for the destroyed node... */
@@ -325,7 +330,7 @@ static void destroy_right(AvlTree tree, AvlTreeNode node)
           tree->destroy((*position)->data);
         }
       /* Now, free the node itself... */
-      free(*position);
+      ALLOCATOR_FREE(tree->alloc, *position);
       *position = NULL;
 
       /* Adjust the size of the tree to account for the destroyed node... */
@@ -638,7 +643,7 @@ static int avltree_insleft(AvlTree tree, AvlTreeNode node, const void *data)
     }
 
   /* Allocate storage for the node */
-  if ((new_node = (AvlTreeNode)malloc(sizeof(struct AvlTreeNode_))) == NULL)
+  if ((new_node = (AvlTreeNode)ALLOCATOR_MALLOC(tree->alloc, sizeof(struct AvlTreeNode_))) == NULL)
     return -1;
 
   /* Insert the node into the tree */
@@ -678,7 +683,7 @@ static int avltree_insright(AvlTree tree, AvlTreeNode node, const void *data)
     }
 
   /* Allocate storage for the node */
-  if ((new_node = (AvlTreeNode)malloc(sizeof(struct AvlTreeNode_))) == NULL)
+  if ((new_node = (AvlTreeNode)ALLOCATOR_MALLOC(tree->alloc, sizeof(struct AvlTreeNode_))) == NULL)
     return -1;
 
   /* Insert the node into the tree */
@@ -13,6 +13,7 @@
  * 
  * 130217 Created this file
  * 150331 This code ready for version 0.51
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
  *
  */
 /**
@@ -23,6 +24,7 @@
 #include <stdlib.h>
 
 #include "bitree.h"
+#include "allocator.h"
 
 /**
  * Macro for level separation when calling BITREEprint()
@@ -47,6 +49,7 @@ struct BiTree_
   int                 (*compare)(const void *key1, const void *key2);
   void                (*destroy)(void *data);
   struct BiTreeNode_   *root;
+  const Allocator      *alloc;
 };
 
 
@@ -62,13 +65,15 @@ static void postorder(BiTreeNode node, void (*callback)(const void *data));
 BiTree BITREEinit(void (*destroy)(void *data))
 {
   BiTree tree;
+  const Allocator *alloc = ALLOCATORget();
 
-  if ((tree = (BiTree)malloc(sizeof(struct BiTree_)))==NULL)
+  if ((tree = (BiTree)ALLOCATOR_MALLOC(alloc, sizeof(struct BiTree_)))==NULL)
     return NULL;
 
   tree->size = 0;
   tree->destroy = destroy;
   tree->root = NULL;
+  tree->alloc = alloc;
 
   return tree;
 }
@@ -79,7 +84,7 @@ void BITREEdestroy(BiTree tree)
   BITREEremleft(tree, NULL);
 
   /* Remove tree header */
-  free(tree);
+  ALLOCATOR_FREE(tree->alloc, tree);
 }
 
 void BITREEsetcompare(BiTree tree, int (*compare)(const void *key1, const void *key2))
@@ -110,7 +115,7 @@ int BITREEinsleft(BiTree tree, BiTreeNode node, const void *data)
     }
 
   /* Allocate storage for the node */
-  if ((new_node = (BiTreeNode)malloc(sizeof(struct BiTreeNode_))) == NULL)
+  if ((new_node = (BiTreeNode)ALLOCATOR_MALLOC(tree->alloc, sizeof(struct BiTreeNode_))) == NULL)
     return -1;
 
   /* Insert the node into the tree */
@@ -148,7 +153,7 @@ int BITREEinsright(BiTree tree, BiTreeNode node, const void *data)
     }
 
   /* Allocate storage for the node */
-  if ((new_node = (BiTreeNode)malloc(sizeof(struct BiTreeNode_))) == NULL)
+  if ((new_node = (BiTreeNode)ALLOCATOR_MALLOC(tree->alloc, sizeof(struct BiTreeNode_))) == NULL)
     return -1;
 
   /* Insert the node into the tree */
@@ -273,7 +278,7 @@ void BITREEremleft(BiTree tree, BiTreeNode node)
           tree->destroy((*position)->data);
         }
 
-      free(*position);
+      ALLOCATOR_FREE(tree->alloc, *position);
       *position = NULL;
 
       /* Adjust the size of the tree to account for the removed node */
@@ -307,7 +312,7 @@ void BITREEremright(BiTree tree, BiTreeNode node)
           tree->destroy((*position)->data);
         }
 
-      free(*position);
+      ALLOCATOR_FREE(tree->alloc, *position);
       *position = NULL;
 
       /* Adjust the size of the tree to account for the removed node */
@@ -456,7 +461,7 @@ static BiTreeNode remnode(BiTree tree, BiTreeNode node,
           assert(ptmp->data);
           *data = ptmp->data;
 
-          free(ptmp);
+          ALLOCATOR_FREE(tree->alloc, ptmp);
           tree->size--;
         }
     }
@@ -0,0 +1,262 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: cchashtbl.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 11:02:14 2026
+ * Version : 0.51
+ * ---
+ * Description: A concurrent, sharded chained hash table - implemented as a pure, generic
+ *              ADT container, on top of CHtbl and POSIX threads.
+ *
+ * Revision history - coming up below:
+ *
+ * Date        Revision message
+ * 2026-10-17  Created this file
+ * 2026-10-17  Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ * 2026-10-17  The key is now hashed once only, per operation - see CHTBLinsert_hash().
+ *
+ */
+
+/**
+ * @file cchashtbl.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "cchashtbl.h"
+#include "allocator.h"
+
+/**
+ * Macro for the size of a cache line
+ *
+ * Every shard - i.e. its lock and table reference - is padded
+ * and aligned to this size, so that threads working on different
+ * shards do not share (and bounce) cache lines between cores.
+ **/
+#define CCHTBL_CACHELINE 64
+
+/* Default load factors of a shard */
+#define CCHTBL_MAXLOAD 1.0
+#define CCHTBL_MINLOAD 0.0
+
+struct CCHtblShard_
+{
+  pthread_rwlock_t lock;
+  CHtbl            table;
+};
+
+/* A shard - padded to a whole number of cache lines */
+typedef union CCHtblSlot_
+{
+  struct CCHtblShard_ shard;
+  char pad[CCHTBL_CACHELINE * ((sizeof(struct CCHtblShard_) + CCHTBL_CACHELINE - 1) / CCHTBL_CACHELINE)];
+} CCHtblSlot;
+
+struct CCHtbl_
+{
+  int        shards;
+  int        (*h)(const void *key);
+  CCHtblSlot *slots;     /* Aligned to a cache line - within 'mem' */
+  void       *mem;
+  const Allocator *alloc;
+};
+
+/* STATIC FUNCTION DECLARATIONS */
+static struct CCHtblShard_ *getshard(const CCHtbl htbl, int hashval);
+
+/* FUNCTION DEFINITIONS */
+
+CCHtbl CCHTBLinit(int shards, int buckets, int (*h)(const void *key), int (*match)(const void *key1, const void *key2), void (*destroy)(void *data))
+{
+  CCHtbl htbl;
+  const Allocator *alloc = ALLOCATORget();
+  int i;
+
+  if (shards < 1)
+    return NULL;
+
+  if ((htbl = (CCHtbl)ALLOCATOR_MALLOC(alloc, sizeof(struct CCHtbl_)))==NULL)
+    return NULL;
+
+  htbl->alloc = alloc;
+
+  if ((htbl->mem = ALLOCATOR_MALLOC(htbl->alloc, shards * sizeof(CCHtblSlot) + CCHTBL_CACHELINE)) == NULL)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl);
+      return NULL;
+    }
+
+  htbl->slots = (CCHtblSlot *)(((size_t)htbl->mem + CCHTBL_CACHELINE - 1) & ~(size_t)(CCHTBL_CACHELINE - 1));
+  htbl->shards = shards;
+  htbl->h = h;
+
+  for (i = 0; i < shards; i++)
+    {
+      struct CCHtblShard_ *shard = &htbl->slots[i].shard;
+
+      if ((shard->table = CHTBLinit_ex(buckets, h, match, destroy, CHTBL_FLAT)) == NULL)
+        break;
+
+      CHTBLsetloadfactor(shard->table, CCHTBL_MAXLOAD, CCHTBL_MINLOAD);
+
+      if (pthread_rwlock_init(&shard->lock, NULL) != 0)
+        {
+          CHTBLdestroy(shard->table);
+          break;
+        }
+    }
+
+  /* Undo what has been set up - on failure */
+  if (i < shards)
+    {
+      while (i--)
+        {
+          pthread_rwlock_destroy(&htbl->slots[i].shard.lock);
+          CHTBLdestroy(htbl->slots[i].shard.table);
+        }
+
+      ALLOCATOR_FREE(htbl->alloc, htbl->mem);
+      ALLOCATOR_FREE(htbl->alloc, htbl);
+      return NULL;
+    }
+
+  return htbl;
+}
+
+void CCHTBLdestroy(CCHtbl htbl)
+{
+  int i;
+
+  for (i = 0; i < htbl->shards; i++)
+    {
+      CHTBLdestroy(htbl->slots[i].shard.table);
+      pthread_rwlock_destroy(&htbl->slots[i].shard.lock);
+    }
+
+  ALLOCATOR_FREE(htbl->alloc, htbl->mem);
+  ALLOCATOR_FREE(htbl->alloc, htbl);
+}
+
+int CCHTBLinsert(CCHtbl htbl, const void *data)
+{
+  int hashval = htbl->h(data);
+  struct CCHtblShard_ *shard = getshard(htbl, hashval);
+  int retval;
+
+  pthread_rwlock_wrlock(&shard->lock);
+  retval = CHTBLinsert_hash(shard->table, hashval, data);
+  pthread_rwlock_unlock(&shard->lock);
+
+  return retval;
+}
+
+int CCHTBLremove(CCHtbl htbl, void **data)
+{
+  int hashval = htbl->h(*data);
+  struct CCHtblShard_ *shard = getshard(htbl, hashval);
+  int retval;
+
+  pthread_rwlock_wrlock(&shard->lock);
+  retval = CHTBLremove_hash(shard->table, hashval, data);
+  pthread_rwlock_unlock(&shard->lock);
+
+  return retval;
+}
+
+int CCHTBLlookup(const CCHtbl htbl, void **data)
+{
+  int hashval = htbl->h(*data);
+  struct CCHtblShard_ *shard = getshard(htbl, hashval);
+  int retval;
+
+  /* A lookup never modifies the table - not even during an incremental rehash -
+     so any number of readers may share the shard */
+  pthread_rwlock_rdlock(&shard->lock);
+  retval = CHTBLlookup_hash(shard->table, hashval, data);
+  pthread_rwlock_unlock(&shard->lock);
+
+  return retval;
+}
+
+int CCHTBLsize(CCHtbl htbl)
+{
+  int i, size = 0;
+
+  for (i = 0; i < htbl->shards; i++)
+    size += CCHTBLshardsize(htbl, i);
+
+  return size;
+}
+
+int CCHTBLshards(CCHtbl htbl)
+{
+  return htbl->shards;
+}
+
+int CCHTBLshardsize(CCHtbl htbl, int shard)
+{
+  struct CCHtblShard_ *sp;
+  int size;
+
+  if (shard < 0 || shard >= htbl->shards)
+    return -1;
+
+  sp = &htbl->slots[shard].shard;
+
+  pthread_rwlock_rdlock(&sp->lock);
+  size = CHTBLsize(sp->table);
+  pthread_rwlock_unlock(&sp->lock);
+
+  return size;
+}
+
+int CCHTBLsetloadfactor(CCHtbl htbl, double maxload, double minload)
+{
+  int i, retval = 0;
+
+  for (i = 0; i < htbl->shards && retval == 0; i++)
+    {
+      pthread_rwlock_wrlock(&htbl->slots[i].shard.lock);
+      retval = CHTBLsetloadfactor(htbl->slots[i].shard.table, maxload, minload);
+      pthread_rwlock_unlock(&htbl->slots[i].shard.lock);
+    }
+
+  return retval;
+}
+
+void CCHTBLprint(CCHtbl htbl, void (*callback)(const void *data))
+{
+  int i;
+
+  for (i = 0; i < htbl->shards; i++)
+    {
+      /* Printing finishes any incremental rehash - i.e. modifies the shard */
+      pthread_rwlock_wrlock(&htbl->slots[i].shard.lock);
+      printf("\nShard #%03d:", i);
+      CHTBLprint(htbl->slots[i].shard.table, callback);
+      pthread_rwlock_unlock(&htbl->slots[i].shard.lock);
+    }
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static struct CCHtblShard_ *getshard(const CCHtbl htbl, int hashval) --- */
+static struct CCHtblShard_ *getshard(const CCHtbl htbl, int hashval)
+{
+  unsigned int hash = (unsigned int)hashval;
+
+  /* Mix the hash value (murmur3 finalizer) - so the shard number does not
+     correlate with the bucket number inside the shard */
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bU;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35U;
+  hash ^= hash >> 16;
+
+  return &htbl->slots[hash % (unsigned int)htbl->shards].shard;
+}
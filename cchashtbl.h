@@ -0,0 +1,228 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: cchashtbl.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 11:02:14 2026
+ * Version : 0.51
+ * ---
+ * Description: A concurrent, sharded chained hash table - implemented as a pure, generic
+ *              ADT container, on top of CHtbl and POSIX threads.
+ *
+ * Revision history - coming up below:
+ *
+ * Date        Revision message
+ * 2026-10-17  Created this file
+ *
+ */
+
+/**
+ * @file cchashtbl.h
+ **/
+
+#ifndef _CCHASHTBL_H_
+#define _CCHASHTBL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "chashtbl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Use a @b typedef - to hide the interior of @b CCHtbl_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct CCHtbl_ *CCHtbl;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Initiate the concurrent hash table
+   *
+   * The key space is split into @a shards independent sub-tables -
+   * each one a @b CHtbl (flat storage engine, automatic resizing
+   * turned on) guarded by its own reader/writer lock. An element is
+   * placed in the shard selected by its (internally mixed) hash value.
+   * Lookups take the lock of one shard for reading only - so any
+   * number of threads can look up elements in parallel, and writers
+   * only block the readers and writers of the shard they modify.
+   * All functions of this interface may be called concurrently from
+   * different threads - except @b CCHTBLinit() and @b CCHTBLdestroy().
+   *
+   * @param[in] shards - The number of sub-tables. A few times the
+   * number of threads accessing the table is a good choice.
+   * @param[in] buckets - The initial number of buckets - of each
+   * sub-table.
+   * @param[in] h - A reference to a user-defined hash function.
+   * This function is called from several threads at once - it must
+   * be thread-safe.
+   * @param[in] match - A reference to a user-defined @a match
+   * function. This function shall return 1 - if @a key1 is equal
+   * to @a key2 - or 0 otherwise. It must be thread-safe, too.
+   * @param[in] destroy - A reference to a user-defined function,
+   * reponsible for freeing @a element @a data, when the table is
+   * destroyed. If @a destroy is set to NULL - then element data will
+   * be left untouched upon table destruction.
+   * @return A reference - to a new, empty table - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise. Take
+   * really good care of this return value, since it will be needed
+   * as a parameter in subsequent calls - to the majority of other
+   * table functions in this function interface - i.e. a sort
+   * of "handle" to the table.
+   * @see CCHTBLdestroy()
+   **/
+  CCHtbl CCHTBLinit(int shards,
+                    int buckets,
+                    int (*h)(const void *key),
+                    int (*match)(const void *key1, const void *key2),
+                    void (*destroy)(void *data));
+
+  /**
+   * Destroy the concurrent hash table
+   *
+   * All sub-tables are destroyed - like @b CHTBLdestroy() - and
+   * the locks released. No other thread may access the table
+   * during - or after - this call.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @return Nothing.
+   * @see CCHTBLinit()
+   **/
+  void CCHTBLdestroy(CCHtbl htbl);
+
+  /**
+   * Insert data into the table
+   *
+   * Works like @b CHTBLinsert() - locking a single shard for writing.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] data - a reference to data to be inserted into
+   * the table.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value 1 - if the element is already present in the table\n
+   *         Value -1 - otherwise (implies fatal error).
+   **/
+  int CCHTBLinsert(CCHtbl htbl, const void *data);
+
+  /**
+   * Remove data from the table
+   *
+   * Works like @b CHTBLremove() - locking a single shard for writing.
+   *
+   * @param[in] htbl - reference to current table.
+   * @param[in,out] data - reference to a pointer. After the call,
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful. The caller is responsible for the future of
+   * this memory - deallocating it, for example.
+   *
+   * @return Value 0 --  if the call was OK - that is, element
+   * found and removed.\n
+   *         Value 1 --  node not found.\n
+   *         Value -2 -- if match-callback is not set.\n
+   *         Value -1 -- otherwise (implies fatal error).
+   **/
+  int CCHTBLremove(CCHtbl htbl, void **data);
+
+  /**
+   * Determine if data exists in the table
+   *
+   * Works like @b CHTBLlookup() - locking a single shard for reading.
+   * Note that element data passed back may be removed - by another
+   * thread - as soon as this call has returned. Protecting data
+   * shared between threads in this way is up to the caller.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in,out] data - a reference to a pointer, pointing at
+   * the data to be searched for - at the call. Upon return - this
+   * pointer has been redirected by this function - and points
+   * instead to data in the element hit - if any.
+   *
+   * @return Value 0 - if element with matching data was found.\n
+   *         Value -1 - otherwise.
+   **/
+  int CCHTBLlookup(const CCHtbl htbl, void **data);
+
+  /**
+   * Get the size of the table
+   *
+   * The sizes of the shards are read one at a time - so the total
+   * is a snapshot only, while other threads modify the table.
+   *
+   * @param[in] htbl - a reference to the current table.
+   *
+   * @return The size, that is, the number of elements
+   * in the table.
+   **/
+  int CCHTBLsize(CCHtbl htbl);
+
+  /**
+   * Get the number of shards of the table
+   *
+   * @param[in] htbl - a reference to the current table.
+   *
+   * @return The number of sub-tables - as given to @b CCHTBLinit().
+   **/
+  int CCHTBLshards(CCHtbl htbl);
+
+  /**
+   * Get the size of a shard
+   *
+   * Handy for checking how evenly the elements are spread over the
+   * shards - i.e. the quality of the hash function.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] shard - a shard number, 0 to @b CCHTBLshards() - 1.
+   *
+   * @return The number of elements in sub-table @a shard - or -1
+   * if @a shard is out of range.
+   **/
+  int CCHTBLshardsize(CCHtbl htbl, int shard);
+
+  /**
+   * Set the load factors of all shards
+   *
+   * Works like @b CHTBLsetloadfactor() - for every sub-table. By
+   * default - the shards grow at 1 element per bucket, and never
+   * shrink.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] maxload - max. load factor. A value <= 0 turns
+   * automatic resizing off.
+   * @param[in] minload - min. load factor. Must be less than half
+   * of @a maxload. A value of 0 means the shards never shrink.
+   *
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - if the load factors were out of range.
+   **/
+  int CCHTBLsetloadfactor(CCHtbl htbl, double maxload, double minload);
+
+  /**
+   * Print all data within the table - on screen
+   *
+   * The shards are printed one after another - like @b CHTBLprint().
+   * Each shard is locked while it is printed.
+   *
+   * @param[in] htbl - reference to current table.
+   * @param[in] callback - reference to user-defined callback function,
+   * that gets @b read @b access to element data via its parameter
+   * @a data - to do whatever is relevant.
+   *
+   * @return - Nothing.
+   **/
+  void CCHTBLprint(CCHtbl htbl, void (*callback)(const void *data));
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CCHASHTBL_H_ */
@@ -18,6 +18,17 @@
  * 2013-02-19  Made some revision to the Doxygen documentation. Enhanced the description of
  *             in/out parameters - i.e. double-pointers.             
  * 2015-03-31  This code ready for version 0.51
+ * 2026-10-17  Added load-factor driven grow/shrink - with incremental rehashing - and the
+ *             new functions CHTBLsetloadfactor(), CHTBLreserve() and CHTBLbuckets().
+ *             Buckets are now created on demand.
+ * 2026-10-17  Added a second storage engine - CHTBL_FLAT - keeping the entries in contiguous
+ *             arrays, together with a cached hash value. See CHTBLinit_ex().
+ * 2026-10-17  The key is now hashed once only, per call to CHTBLinsert().
+ * 2026-10-17  Added batch functions - CHTBLinsert_batch() and CHTBLlookup_batch() - hashing
+ *             a group of keys and prefetching their buckets, before resolving them.
+ * 2026-10-17  Added iteration - CHTBLfirst(), CHTBLnext() - and a parallel CHTBLforeach().
+ * 2026-10-17  Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ * 2026-10-17  Added CHTBLinsert_hash(), CHTBLremove_hash() and CHTBLlookup_hash().
  *
  */
 
@@ -27,9 +38,59 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 #include "chashtbl.h"
+#include "allocator.h"
 
+/**
+ * Macro for the number of buckets moved per operation
+ * 
+ * This macro sets the number of (non-empty) buckets that 
+ * are moved from the old to the new bucket array - on every
+ * call to CHTBLinsert() or CHTBLremove() - while an 
+ * incremental rehash is in progress.
+ **/
+#define CHTBL_REHASH_STEP 4
+
+/**
+ * Macro for the max number of empty buckets visited per rehash step
+ **/
+#define CHTBL_REHASH_EMPTY_VISITS (10*CHTBL_REHASH_STEP)
+
+/* Initial number of entries in the overflow pool of a CHTBL_FLAT table */
+#define CHTBL_POOL_MINSIZE 16
+
+/* Link values of the 'next' member of a CHTBL_FLAT entry */
+#define CHTBL_EMPTY 0  /* Unused bucket slot - pool entry 0 is never used */
+#define CHTBL_LAST -1  /* Last entry of a chain */
+
+/* Number of keys hashed and prefetched together - by the batch functions */
+#define CHTBL_BATCH 16
+
+/* Software prefetch of a bucket - where supported by the compiler */
+#if defined(__GNUC__)
+#define CHTBL_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define CHTBL_PREFETCH(addr) ((void)0)
+#endif
+
+/* True while an incremental rehash is in progress */
+#define REHASHING(htbl) ((htbl)->newbuckets > 0)
+
+/* Max. number of threads used by CHTBLforeach() */
+#define CHTBL_MAXTHREADS 64
+
+/* An entry of a CHTBL_FLAT table - the 1st entry of each chain is 
+   stored in the bucket array itself, the rest in the overflow pool */
+struct CHtblEntry_
+{
+  unsigned int hash;
+  int          next;
+  void         *data;
+};
 
 struct CHtbl_
 {
@@ -39,116 +100,1024 @@ struct CHtbl_
   int   (*match)(const void *key1, const void *key2);
   void  (*destroy)(void *data);
   int   size;
+  int   engine;
+  const Allocator *alloc;
+
+  /* Bucket arrays - CHTBL_SLIST engine */
   Slist *table;
+  Slist *newtable;
+
+  /* Bucket arrays and overflow pool - CHTBL_FLAT engine */
+  struct CHtblEntry_ *flat;
+  struct CHtblEntry_ *newflat;
+  struct CHtblEntry_ *pool;
+  int   poolsize;
+  int   poolused;
+  int   poolfree;
+
+  /* Automatic resizing - disabled when maxload <= 0 */
+  double maxload;
+  double minload;
+  int   minbuckets;
+
+  /* Incremental rehashing - in progress when newbuckets > 0 */
+  int   newbuckets;
+  int   rehashidx;
 };
 
+/* A range of buckets - scanned by one thread of CHTBLforeach() */
+struct CHtblRange_
+{
+  CHtbl htbl;
+  int   from;
+  int   to;
+  void  (*callback)(void *data, void *arg);
+  void  *arg;
+};
 
+/* STATIC FUNCTION DECLARATIONS */
+static int hashpos(int hashval, int buckets);
+static int table_lookup(CHtbl htbl, int hashval, void **data);
+static int table_insert(CHtbl htbl, int hashval, const void *data);
+static int table_remove(CHtbl htbl, int hashval, void **data);
+static void prefetch_bucket(CHtbl htbl, int hashval);
+static int bucket_lookup(CHtbl htbl, int newer, int hashval, void **data);
+static int bucket_insert(CHtbl htbl, int newer, int hashval, const void *data);
+static int bucket_remove(CHtbl htbl, int newer, int hashval, void **data);
+static int bucket_move(CHtbl htbl, int bucket);
+static void bucket_print(CHtbl htbl, int bucket, void (*callback)(const void *data));
+static Slist getbucket(CHtbl htbl, Slist *table, int bucket);
+static void destroy_table(CHtbl htbl, Slist *table, int buckets);
+static void destroy_flat(CHtbl htbl, struct CHtblEntry_ *flat, int buckets);
+static int pool_reserve(CHtbl htbl);
+static int pool_alloc(CHtbl htbl);
+static void pool_free(CHtbl htbl, int idx);
+static void flat_link(CHtbl htbl, struct CHtblEntry_ *flat, int bucket, int idx);
+static int start_rehash(CHtbl htbl, int newbuckets);
+static int rehash_step(CHtbl htbl, int steps);
+static void check_load(CHtbl htbl);
+static struct CHtblEntry_ *iter_flat(CHtbl htbl, int bucket);
+static int iter_seek(CHtbl htbl, CHtblIter *iter, int end, void **data);
+static int iter_step(CHtbl htbl, CHtblIter *iter, int end, void **data);
+static void *foreach_range(void *range);
 
 /* FUNCTION DEFINITIONS --------------------------------------------------- */
 
 CHtbl CHTBLinit(int buckets, int (*h)(const void *key), int (*match)(const void *key1, const void *key2), void (*destroy)(void *data))
+{
+  return CHTBLinit_ex(buckets, h, match, destroy, CHTBL_SLIST);
+}
+
+CHtbl CHTBLinit_ex(int buckets, int (*h)(const void *key), int (*match)(const void *key1, const void *key2), void (*destroy)(void *data), int engine)
 {
   CHtbl htbl;
-  int i;
+  const Allocator *alloc = ALLOCATORget();
 
-  if ((htbl = (CHtbl)malloc(sizeof(struct CHtbl_)))==NULL)
+  if (engine != CHTBL_SLIST && engine != CHTBL_FLAT)
     return NULL;
 
-  if ((htbl->table = (Slist *)malloc(buckets * sizeof(Slist))) == NULL)
+  if ((htbl = (CHtbl)ALLOCATOR_MALLOC(alloc, sizeof(struct CHtbl_)))==NULL)
     return NULL;
 
-  htbl->buckets = buckets;
+  htbl->table = NULL;
+  htbl->newtable = NULL;
+  htbl->flat = NULL;
+  htbl->newflat = NULL;
+  htbl->pool = NULL;
+  htbl->poolsize = 0;
+  htbl->poolused = 1;
+  htbl->poolfree = CHTBL_EMPTY;
+
+  /* Buckets are created on demand - or zero-filled - no per-bucket setup */
+  if (engine == CHTBL_SLIST)
+    htbl->table = (Slist *)ALLOCATORcalloc(alloc, buckets, sizeof(Slist));
+  else
+    htbl->flat = (struct CHtblEntry_ *)ALLOCATORcalloc(alloc, buckets, sizeof(struct CHtblEntry_));
 
-  for (i = 0; i < htbl->buckets; i++)
+  if (htbl->table == NULL && htbl->flat == NULL)
     {
-      if ((htbl->table[i] = SLISTinit(destroy)) == NULL)
-        return NULL;
-      SLISTsetmatch(htbl->table[i], match);
+      ALLOCATOR_FREE(alloc, htbl);
+      return NULL;
     }
 
+  htbl->buckets = buckets;
   htbl->h = h;
   htbl->match = match;
   htbl->destroy = destroy;
   htbl->size = 0;
+  htbl->engine = engine;
+  htbl->alloc = alloc;
+
+  htbl->maxload = 0.0;
+  htbl->minload = 0.0;
+  htbl->minbuckets = buckets;
+
+  htbl->newbuckets = 0;
+  htbl->rehashidx = 0;
 
   return htbl;
 }
 
 void CHTBLdestroy(CHtbl htbl)
+{
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      destroy_table(htbl, htbl->table, htbl->buckets);
+
+      if (REHASHING(htbl))
+        destroy_table(htbl, htbl->newtable, htbl->newbuckets);
+    }
+  else
+    {
+      destroy_flat(htbl, htbl->flat, htbl->buckets);
+
+      if (REHASHING(htbl))
+        destroy_flat(htbl, htbl->newflat, htbl->newbuckets);
+
+      ALLOCATOR_FREE(htbl->alloc, htbl->pool);
+    }
+
+  ALLOCATOR_FREE(htbl->alloc, htbl);
+}
+
+int CHTBLinsert(CHtbl htbl, const void *data)
+{
+  /* Hash the key - once, for both the lookup and the insertion */
+  return table_insert(htbl, htbl->h(data), data);
+}
+
+int CHTBLinsert_batch(CHtbl htbl, const void **data, int n, int *results)
+{
+  int hashvals[CHTBL_BATCH];
+  int i, j, cnt, retval, inserted = 0;
+
+  for (i = 0; i < n; i += CHTBL_BATCH)
+    {
+      cnt = n - i < CHTBL_BATCH ? n - i : CHTBL_BATCH;
+
+      /* Hash all keys of the group - and prefetch their buckets.. */
+      for (j = 0; j < cnt; j++)
+        {
+          hashvals[j] = htbl->h(data[i + j]);
+          prefetch_bucket(htbl, hashvals[j]);
+        }
+
+      /* ..then resolve them, while the buckets are on their way to the cache */
+      for (j = 0; j < cnt; j++)
+        {
+          retval = table_insert(htbl, hashvals[j], data[i + j]);
+
+          if (results != NULL)
+            results[i + j] = retval;
+
+          if (retval == 0)
+            inserted++;
+        }
+    }
+
+  return inserted;
+}
+
+int CHTBLremove(CHtbl htbl, void **data)
+{
+  /* If match-callback not set */
+  if (htbl->match == NULL)
+    return -2;
+
+  return table_remove(htbl, htbl->h(*data), data);
+}
+
+int CHTBLlookup(const CHtbl htbl, void **data)
+{
+  return table_lookup(htbl, htbl->h(*data), data);
+}
+
+int CHTBLinsert_hash(CHtbl htbl, int hashval, const void *data)
+{
+  return table_insert(htbl, hashval, data);
+}
+
+int CHTBLremove_hash(CHtbl htbl, int hashval, void **data)
+{
+  if (htbl->match == NULL)
+    return -2;
+
+  return table_remove(htbl, hashval, data);
+}
+
+int CHTBLlookup_hash(const CHtbl htbl, int hashval, void **data)
+{
+  return table_lookup(htbl, hashval, data);
+}
+
+int CHTBLlookup_batch(const CHtbl htbl, void **data, int n, int *results)
+{
+  int hashvals[CHTBL_BATCH];
+  int i, j, cnt, retval, found = 0;
+
+  for (i = 0; i < n; i += CHTBL_BATCH)
+    {
+      cnt = n - i < CHTBL_BATCH ? n - i : CHTBL_BATCH;
+
+      /* Hash all keys of the group - and prefetch their buckets.. */
+      for (j = 0; j < cnt; j++)
+        {
+          hashvals[j] = htbl->h(data[i + j]);
+          prefetch_bucket(htbl, hashvals[j]);
+        }
+
+      /* ..then resolve them, while the buckets are on their way to the cache */
+      for (j = 0; j < cnt; j++)
+        {
+          retval = table_lookup(htbl, hashvals[j], &data[i + j]);
+
+          if (results != NULL)
+            results[i + j] = retval;
+
+          if (retval == 0)
+            found++;
+        }
+    }
+
+  return found;
+}
+
+void CHTBLprint(CHtbl htbl, void (*callback)(const void *data))
 {
   int i;
 
+  /* Complete any ongoing rehash - to get one single bucket array to print */
+  if (REHASHING(htbl))
+    rehash_step(htbl, htbl->buckets);
+
   for (i = 0; i < htbl->buckets; ++i)
     {
-      SLISTdestroy(htbl->table[i]);
+      printf("\nBucket #%03d: ", i);
+      bucket_print(htbl, i, callback);
+    }
+}
+
+int CHTBLfirst(CHtbl htbl, CHtblIter *iter, void **data)
+{
+  /* Buckets below the rehash index have been moved to the new bucket array already */
+  iter->bucket = REHASHING(htbl) ? htbl->rehashidx : 0;
+  iter->left = htbl->size;
+
+  if (iter->left == 0 || iter_seek(htbl, iter, htbl->buckets + htbl->newbuckets, data) != 0)
+    return -1;
+
+  iter->left--;
+  return 0;
+}
+
+int CHTBLnext(CHtbl htbl, CHtblIter *iter, void **data)
+{
+  /* All elements visited - do not scan the remaining (empty) buckets */
+  if (iter->left == 0 || iter_step(htbl, iter, htbl->buckets + htbl->newbuckets, data) != 0)
+    return -1;
+
+  iter->left--;
+  return 0;
+}
+
+void CHTBLforeach(CHtbl htbl, void (*callback)(void *data, void *arg), void *arg, int nthreads)
+{
+  struct CHtblRange_ range[CHTBL_MAXTHREADS];
+#ifndef _WIN32
+  pthread_t thread[CHTBL_MAXTHREADS];
+  int started[CHTBL_MAXTHREADS];
+#endif
+  int first, total, i;
+
+  first = REHASHING(htbl) ? htbl->rehashidx : 0;
+  total = htbl->buckets + htbl->newbuckets - first;
+
+  if (nthreads > CHTBL_MAXTHREADS)
+    nthreads = CHTBL_MAXTHREADS;
+
+  if (nthreads > total)
+    nthreads = total;
+
+  if (nthreads < 1)
+    nthreads = 1;
+
+  /* Split the buckets into ranges of (almost) equal size */
+  for (i = 0; i < nthreads; i++)
+    {
+      range[i].htbl = htbl;
+      range[i].from = first + (int)((double)total * i / nthreads);
+      range[i].to = first + (int)((double)total * (i + 1) / nthreads);
+      range[i].callback = callback;
+      range[i].arg = arg;
     }
 
-  free(htbl->table);
-  free(htbl);
+#ifndef _WIN32
+  /* One range is left for the calling thread */
+  for (i = 1; i < nthreads; i++)
+    started[i] = pthread_create(&thread[i], NULL, foreach_range, &range[i]) == 0;
+
+  foreach_range(&range[0]);
+
+  for (i = 1; i < nthreads; i++)
+    {
+      if (started[i])
+        pthread_join(thread[i], NULL);
+      else
+        foreach_range(&range[i]);
+    }
+#else
+  for (i = 0; i < nthreads; i++)
+    foreach_range(&range[i]);
+#endif
 }
 
-int CHTBLinsert(CHtbl htbl, const void *data)
+int CHTBLsize(CHtbl htbl)
+{
+  return htbl->size;
+}
+
+int CHTBLbuckets(CHtbl htbl)
+{
+  return REHASHING(htbl) ? htbl->newbuckets : htbl->buckets;
+}
+
+int CHTBLsetloadfactor(CHtbl htbl, double maxload, double minload)
+{
+  if (maxload <= 0.0)
+    {
+      /* Turn automatic resizing off */
+      htbl->maxload = 0.0;
+      htbl->minload = 0.0;
+      return 0;
+    }
+
+  /* A shrink must not immediately trigger a new grow - and vice versa */
+  if (minload < 0.0 || 2.0 * minload >= maxload)
+    return -1;
+
+  htbl->maxload = maxload;
+  htbl->minload = minload;
+
+  check_load(htbl);
+
+  return 0;
+}
+
+int CHTBLreserve(CHtbl htbl, int elements)
+{
+  int buckets;
+
+  if (elements < 0)
+    return -1;
+
+  /* Finish any ongoing rehash first */
+  if (REHASHING(htbl) && rehash_step(htbl, htbl->buckets) != 0)
+    return -1;
+
+  buckets = htbl->maxload > 0.0 ? (int)(elements / htbl->maxload) + 1 : elements;
+
+  /* Never shrink below the reserved number of buckets */
+  if (buckets > htbl->minbuckets)
+    htbl->minbuckets = buckets;
+
+  if (buckets <= htbl->buckets)
+    return 0;
+
+  /* Pre-sizing is explicit - so do the whole rehash right away */
+  if (start_rehash(htbl, buckets) != 0)
+    return -1;
+
+  return rehash_step(htbl, htbl->buckets);
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static int hashpos(int hashval, int buckets) --- */
+static int hashpos(int hashval, int buckets)
+{
+  return (int)((unsigned int)hashval % (unsigned int)buckets);
+}
+
+/* --- Function: static int table_lookup(CHtbl htbl, int hashval, void **data) --- */
+static int table_lookup(CHtbl htbl, int hashval, void **data)
 {
-  int bucket, retval;
+  if (bucket_lookup(htbl, 0, hashval, data) == 0)
+    return 0;
+
+  /* During a rehash - the element may have been moved already */
+  if (REHASHING(htbl) && bucket_lookup(htbl, 1, hashval, data) == 0)
+    return 0;
+
+  return -1;
+}
+
+/* --- Function: static int table_insert(CHtbl htbl, int hashval, const void *data) --- */
+static int table_insert(CHtbl htbl, int hashval, const void *data)
+{
+  int retval;
   void *tmp;
 
+  /* Move a few buckets - if a rehash is in progress */
+  if (REHASHING(htbl))
+    rehash_step(htbl, CHTBL_REHASH_STEP);
+
   tmp = (void *)data;
 
-  if (CHTBLlookup(htbl, &tmp) == 0)
+  if (table_lookup(htbl, hashval, &tmp) == 0)
     return 1;
 
-  /* Hash the key */
-  bucket = htbl->h(data) % htbl->buckets;
-
-  if ((retval = SLISTinsnext(htbl->table[bucket], NULL, data)) == 0)
-    htbl->size++;
+  /* New elements always go to the newest bucket array */
+  if ((retval = bucket_insert(htbl, REHASHING(htbl), hashval, data)) == 0)
+    {
+      htbl->size++;
+      check_load(htbl);
+    }
 
   return retval;
 }
 
-int CHTBLremove(CHtbl htbl, void **data)
+/* --- Function: static int table_remove(CHtbl htbl, int hashval, void **data) --- */
+static int table_remove(CHtbl htbl, int hashval, void **data)
 {
-  int bucket, retval;
+  int retval;
+
+  /* Move a few buckets - if a rehash is in progress */
+  if (REHASHING(htbl))
+    rehash_step(htbl, CHTBL_REHASH_STEP);
+
+  /* Search the old bucket array first - and then the new one, during a rehash */
+  retval = bucket_remove(htbl, 0, hashval, data);
 
-  /* Hash the key */
-  bucket = htbl->h(*data) % htbl->buckets;
+  if (retval == 1 && REHASHING(htbl))
+    retval = bucket_remove(htbl, 1, hashval, data);
 
-  /* Remove the node */
-  if ((retval = SLISTfind_remove(htbl->table[bucket], data)) == 0) /* Node removal successful.. */
-    htbl->size--;
+  if (retval == 0) /* Node removal successful.. */
+    {
+      htbl->size--;
+      check_load(htbl);
+    }
 
   return retval;
 }
 
-int CHTBLlookup(const CHtbl htbl, void **data)
+/* --- Function: static void prefetch_bucket(CHtbl htbl, int hashval) --- */
+static void prefetch_bucket(CHtbl htbl, int hashval)
+{
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      CHTBL_PREFETCH(&htbl->table[hashpos(hashval, htbl->buckets)]);
+
+      if (REHASHING(htbl))
+        CHTBL_PREFETCH(&htbl->newtable[hashpos(hashval, htbl->newbuckets)]);
+    }
+  else
+    {
+      CHTBL_PREFETCH(&htbl->flat[hashpos(hashval, htbl->buckets)]);
+
+      if (REHASHING(htbl))
+        CHTBL_PREFETCH(&htbl->newflat[hashpos(hashval, htbl->newbuckets)]);
+    }
+}
+
+/* --- Function: static int bucket_lookup(CHtbl htbl, int newer, int hashval, void **data) --- */
+static int bucket_lookup(CHtbl htbl, int newer, int hashval, void **data)
 {
   int bucket;
+  Slist list;
   SlistNode tmpnode;
+  struct CHtblEntry_ *entry;
 
-  /* Hash the key */
-  bucket = htbl->h(*data) % htbl->buckets;
+  bucket = hashpos(hashval, newer ? htbl->newbuckets : htbl->buckets);
 
-  if ((tmpnode = SLISTfindnode(htbl->table[bucket], *data))) /* Data found */
+  if (htbl->engine == CHTBL_SLIST)
     {
-      *data = SLISTdata(tmpnode); /* Pass data back to caller */
+      list = newer ? htbl->newtable[bucket] : htbl->table[bucket];
+
+      if (list != NULL && (tmpnode = SLISTfindnode(list, *data))) /* Data found */
+        {
+          *data = SLISTdata(tmpnode); /* Pass data back to caller */
+          return 0;
+        }
+      return -1;
+    }
+
+  entry = newer ? &htbl->newflat[bucket] : &htbl->flat[bucket];
+
+  if (entry->next == CHTBL_EMPTY || htbl->match == NULL)
+    return -1;
+
+  /* Only call match() when the cached hash values agree */
+  while (1)
+    {
+      if (entry->hash == (unsigned int)hashval && htbl->match(*data, entry->data))
+        {
+          *data = entry->data; /* Pass data back to caller */
+          return 0;
+        }
+
+      if (entry->next == CHTBL_LAST)
+        return -1;
+
+      entry = &htbl->pool[entry->next];
+    }
+}
+
+/* --- Function: static int bucket_insert(CHtbl htbl, int newer, int hashval, const void *data) --- */
+static int bucket_insert(CHtbl htbl, int newer, int hashval, const void *data)
+{
+  int bucket, idx;
+  Slist list;
+  struct CHtblEntry_ *entry;
+
+  bucket = hashpos(hashval, newer ? htbl->newbuckets : htbl->buckets);
+
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      if ((list = getbucket(htbl, newer ? htbl->newtable : htbl->table, bucket)) == NULL)
+        return -1;
+
+      return SLISTinsnext(list, NULL, data);
+    }
+
+  entry = newer ? &htbl->newflat[bucket] : &htbl->flat[bucket];
+
+  /* Empty bucket - store the entry in the bucket array itself */
+  if (entry->next == CHTBL_EMPTY)
+    {
+      entry->hash = (unsigned int)hashval;
+      entry->data = (void *)data;
+      entry->next = CHTBL_LAST;
       return 0;
     }
 
-  return -1;
+  /* Otherwise - link in an overflow entry, as the 2nd entry of the chain */
+  if ((idx = pool_alloc(htbl)) < 0)
+    return -1;
+
+  htbl->pool[idx].hash = (unsigned int)hashval;
+  htbl->pool[idx].data = (void *)data;
+  htbl->pool[idx].next = entry->next;
+  entry->next = idx;
+
+  return 0;
 }
 
-void CHTBLprint(CHtbl htbl, void (*callback)(const void *data))
+/* --- Function: static int bucket_remove(CHtbl htbl, int newer, int hashval, void **data) --- */
+static int bucket_remove(CHtbl htbl, int newer, int hashval, void **data)
+{
+  int bucket, idx;
+  Slist list;
+  struct CHtblEntry_ *entry, *prev;
+
+  bucket = hashpos(hashval, newer ? htbl->newbuckets : htbl->buckets);
+
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      list = newer ? htbl->newtable[bucket] : htbl->table[bucket];
+
+      return list != NULL ? SLISTfind_remove(list, data) : 1;
+    }
+
+  entry = newer ? &htbl->newflat[bucket] : &htbl->flat[bucket];
+  prev = NULL;
+
+  if (entry->next == CHTBL_EMPTY)
+    return 1;
+
+  while (1)
+    {
+      if (entry->hash == (unsigned int)hashval && htbl->match(*data, entry->data))
+        break;
+
+      if (entry->next == CHTBL_LAST) /* Node not found */
+        return 1;
+
+      prev = entry;
+      entry = &htbl->pool[entry->next];
+    }
+
+  /* Pass data back to caller */
+  *data = entry->data;
+
+  if (prev != NULL)
+    {
+      /* Unlink the entry from the overflow pool */
+      idx = prev->next;
+      prev->next = entry->next;
+      pool_free(htbl, idx);
+    }
+  else if (entry->next == CHTBL_LAST)
+    {
+      /* Last entry of the bucket */
+      entry->next = CHTBL_EMPTY;
+      entry->data = NULL;
+    }
+  else
+    {
+      /* Pull up the 2nd entry of the chain - into the bucket array */
+      idx = entry->next;
+      *entry = htbl->pool[idx];
+      pool_free(htbl, idx);
+    }
+
+  return 0;
+}
+
+/* --- Function: static int bucket_move(CHtbl htbl, int bucket) --- */
+static int bucket_move(CHtbl htbl, int bucket)
+{
+  int idx, next, retval;
+  void *data;
+  Slist list, newlist;
+  struct CHtblEntry_ *entry;
+
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      if ((list = htbl->table[bucket]) == NULL)
+        return 1;
+
+      retval = SLISTsize(list) > 0 ? 0 : 1;
+
+      /* Move all elements of this bucket to the new bucket array */
+      while (SLISTsize(list) > 0)
+        {
+          data = SLISTdata(SLISThead(list));
+
+          /* Insert before unlinking - so nothing is lost if memory runs out */
+          if ((newlist = getbucket(htbl, htbl->newtable, hashpos(htbl->h(data), htbl->newbuckets))) == NULL ||
+              SLISTinsnext(newlist, NULL, data) != 0)
+            return -1;
+
+          SLISTremnext(list, NULL, &data);
+        }
+
+      SLISTdestroy(list);
+      htbl->table[bucket] = NULL;
+
+      return retval;
+    }
+
+  entry = &htbl->flat[bucket];
+
+  if (entry->next == CHTBL_EMPTY)
+    return 1;
+
+  /* Moving needs at most one new pool entry - for the 1st entry of the chain.
+     Get it now - the pool may be reallocated. The hash values are cached, so
+     the user-defined hash function is never called here. */
+  if (pool_reserve(htbl) != 0)
+    return -1;
+
+  idx = pool_alloc(htbl);
+  htbl->pool[idx].hash = entry->hash;
+  htbl->pool[idx].data = entry->data;
+  next = entry->next;
+
+  entry->next = CHTBL_EMPTY;
+  entry->data = NULL;
+
+  /* Relink all the entries - no copying of overflow entries needed */
+  while (1)
+    {
+      flat_link(htbl, htbl->newflat, hashpos(htbl->pool[idx].hash, htbl->newbuckets), idx);
+
+      if (next == CHTBL_LAST)
+        break;
+
+      idx = next;
+      next = htbl->pool[idx].next;
+    }
+
+  return 0;
+}
+
+/* --- Function: static void bucket_print(CHtbl htbl, int bucket, void (*callback)(const void *data)) --- */
+static void bucket_print(CHtbl htbl, int bucket, void (*callback)(const void *data))
+{
+  struct CHtblEntry_ *entry;
+
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      if (htbl->table[bucket] != NULL)
+        SLISTtraverse(htbl->table[bucket], callback, SLIST_FWD);
+      return;
+    }
+
+  entry = &htbl->flat[bucket];
+
+  if (entry->next == CHTBL_EMPTY)
+    return;
+
+  while (1)
+    {
+      callback(entry->data);
+
+      if (entry->next == CHTBL_LAST)
+        break;
+
+      entry = &htbl->pool[entry->next];
+    }
+}
+
+/* --- Function: static Slist getbucket(CHtbl htbl, Slist *table, int bucket) --- */
+static Slist getbucket(CHtbl htbl, Slist *table, int bucket)
+{
+  /* Create the bucket list - with the allocator of the table - if not already done */
+  if (table[bucket] == NULL)
+    {
+      if ((table[bucket] = SLISTinit_alloc(htbl->destroy, htbl->alloc)) == NULL)
+        return NULL;
+      SLISTsetmatch(table[bucket], htbl->match);
+    }
+
+  return table[bucket];
+}
+
+/* --- Function: static void destroy_table(CHtbl htbl, Slist *table, int buckets) --- */
+static void destroy_table(CHtbl htbl, Slist *table, int buckets)
 {
   int i;
 
-  for (i = 0; i < htbl->buckets; ++i)
+  for (i = 0; i < buckets; ++i)
     {
-      printf("\nBucket #%03d: ", i);
-      SLISTtraverse(htbl->table[i], callback, SLIST_FWD);
+      if (table[i] != NULL)
+        SLISTdestroy(table[i]);
     }
+
+  ALLOCATOR_FREE(htbl->alloc, table);
 }
 
-int CHTBLsize(CHtbl htbl)
+/* --- Function: static void destroy_flat(CHtbl htbl, struct CHtblEntry_ *flat, int buckets) --- */
+static void destroy_flat(CHtbl htbl, struct CHtblEntry_ *flat, int buckets)
 {
-  return htbl->size;
+  int i;
+  struct CHtblEntry_ *entry;
+
+  if (htbl->destroy != NULL)
+    {
+      for (i = 0; i < buckets; ++i)
+        {
+          entry = &flat[i];
+
+          if (entry->next == CHTBL_EMPTY)
+            continue;
+
+          while (1)
+            {
+              htbl->destroy(entry->data);
+
+              if (entry->next == CHTBL_LAST)
+                break;
+
+              entry = &htbl->pool[entry->next];
+            }
+        }
+    }
+
+  ALLOCATOR_FREE(htbl->alloc, flat);
+}
+
+/* --- Function: static int pool_reserve(CHtbl htbl) --- */
+static int pool_reserve(CHtbl htbl)
+{
+  int newsize;
+  struct CHtblEntry_ *tmp;
+
+  /* Free entries available? */
+  if (htbl->poolfree != CHTBL_EMPTY || htbl->poolused < htbl->poolsize)
+    return 0;
+
+  newsize = htbl->poolsize ? 2 * htbl->poolsize : CHTBL_POOL_MINSIZE;
+
+  if ((tmp = (struct CHtblEntry_ *)ALLOCATOR_REALLOC(htbl->alloc, htbl->pool, newsize * sizeof(struct CHtblEntry_))) == NULL)
+    return -1;
+
+  htbl->pool = tmp;
+  htbl->poolsize = newsize;
+
+  return 0;
+}
+
+/* --- Function: static int pool_alloc(CHtbl htbl) --- */
+static int pool_alloc(CHtbl htbl)
+{
+  int idx;
+
+  if (pool_reserve(htbl) != 0)
+    return -1;
+
+  /* Reuse a freed entry - if any */
+  if (htbl->poolfree != CHTBL_EMPTY)
+    {
+      idx = htbl->poolfree;
+      htbl->poolfree = htbl->pool[idx].next;
+      return idx;
+    }
+
+  return htbl->poolused++;
+}
+
+/* --- Function: static void pool_free(CHtbl htbl, int idx) --- */
+static void pool_free(CHtbl htbl, int idx)
+{
+  htbl->pool[idx].data = NULL;
+  htbl->pool[idx].next = htbl->poolfree;
+  htbl->poolfree = idx;
+}
+
+/* --- Function: static void flat_link(CHtbl htbl, struct CHtblEntry_ *flat, int bucket, int idx) --- */
+static void flat_link(CHtbl htbl, struct CHtblEntry_ *flat, int bucket, int idx)
+{
+  struct CHtblEntry_ *entry = &flat[bucket];
+
+  /* Empty bucket - move the entry into the bucket array itself */
+  if (entry->next == CHTBL_EMPTY)
+    {
+      *entry = htbl->pool[idx];
+      entry->next = CHTBL_LAST;
+      pool_free(htbl, idx);
+      return;
+    }
+
+  /* Otherwise - link it in, as the 2nd entry of the chain */
+  htbl->pool[idx].next = entry->next;
+  entry->next = idx;
+}
+
+/* --- Function: static int start_rehash(CHtbl htbl, int newbuckets) --- */
+static int start_rehash(CHtbl htbl, int newbuckets)
+{
+  if (REHASHING(htbl) || newbuckets < 1 || newbuckets == htbl->buckets)
+    return -1;
+
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      if ((htbl->newtable = (Slist *)ALLOCATORcalloc(htbl->alloc, newbuckets, sizeof(Slist))) == NULL)
+        return -1;
+    }
+  else
+    {
+      if ((htbl->newflat = (struct CHtblEntry_ *)ALLOCATORcalloc(htbl->alloc, newbuckets, sizeof(struct CHtblEntry_))) == NULL)
+        return -1;
+    }
+
+  htbl->newbuckets = newbuckets;
+  htbl->rehashidx = 0;
+
+  return 0;
+}
+
+/* --- Function: static int rehash_step(CHtbl htbl, int steps) --- */
+static int rehash_step(CHtbl htbl, int steps)
+{
+  int empty_visits, retval;
+
+  /* A complete rehash is never interrupted by empty buckets */
+  empty_visits = steps >= htbl->buckets ? htbl->buckets + 1 : CHTBL_REHASH_EMPTY_VISITS;
+
+  while (steps > 0 && htbl->rehashidx < htbl->buckets)
+    {
+      if ((retval = bucket_move(htbl, htbl->rehashidx)) < 0)
+        return -1;
+
+      htbl->rehashidx++;
+
+      if (retval == 0)
+        steps--;
+      else if (--empty_visits == 0) /* Do not spend too much time on empty buckets.. */
+        return 0;
+    }
+
+  /* All buckets moved - the new bucket array takes over */
+  if (htbl->rehashidx >= htbl->buckets)
+    {
+      if (htbl->engine == CHTBL_SLIST)
+        {
+          ALLOCATOR_FREE(htbl->alloc, htbl->table);
+          htbl->table = htbl->newtable;
+          htbl->newtable = NULL;
+        }
+      else
+        {
+          ALLOCATOR_FREE(htbl->alloc, htbl->flat);
+          htbl->flat = htbl->newflat;
+          htbl->newflat = NULL;
+        }
+
+      htbl->buckets = htbl->newbuckets;
+      htbl->newbuckets = 0;
+      htbl->rehashidx = 0;
+    }
+
+  return 0;
+}
+
+/* --- Function: static void check_load(CHtbl htbl) --- */
+static void check_load(CHtbl htbl)
+{
+  int buckets;
+
+  /* Resizing off - or already in progress */
+  if (htbl->maxload <= 0.0 || REHASHING(htbl))
+    return;
+
+  if (htbl->size > htbl->maxload * htbl->buckets)
+    start_rehash(htbl, 2 * htbl->buckets);
+  else if (htbl->size < htbl->minload * htbl->buckets && htbl->buckets > htbl->minbuckets)
+    {
+      buckets = htbl->buckets / 2;
+      start_rehash(htbl, buckets < htbl->minbuckets ? htbl->minbuckets : buckets);
+    }
+}
+
+/* --- Function: static struct CHtblEntry_ *iter_flat(CHtbl htbl, int bucket) --- */
+static struct CHtblEntry_ *iter_flat(CHtbl htbl, int bucket)
+{
+  /* During a rehash - the buckets of the new array follow those of the old one */
+  return bucket < htbl->buckets ? &htbl->flat[bucket] : &htbl->newflat[bucket - htbl->buckets];
+}
+
+/* --- Function: static int iter_seek(CHtbl htbl, CHtblIter *iter, int end, void **data) --- */
+static int iter_seek(CHtbl htbl, CHtblIter *iter, int end, void **data)
+{
+  struct CHtblEntry_ *entry;
+  Slist list;
+
+  /* Find the first non-empty bucket - from the current one, up to 'end' */
+  for (; iter->bucket < end; iter->bucket++)
+    {
+      if (htbl->engine == CHTBL_SLIST)
+        {
+          list = iter->bucket < htbl->buckets ? htbl->table[iter->bucket] : htbl->newtable[iter->bucket - htbl->buckets];
+
+          if (list != NULL && SLISTsize(list) > 0)
+            {
+              iter->node = SLISThead(list);
+              *data = SLISTdata(iter->node);
+              return 0;
+            }
+        }
+      else
+        {
+          entry = iter_flat(htbl, iter->bucket);
+
+          if (entry->next != CHTBL_EMPTY)
+            {
+              iter->entry = 0;
+              *data = entry->data;
+              return 0;
+            }
+        }
+    }
+
+  return -1;
+}
+
+/* --- Function: static int iter_step(CHtbl htbl, CHtblIter *iter, int end, void **data) --- */
+static int iter_step(CHtbl htbl, CHtblIter *iter, int end, void **data)
+{
+  int next;
+
+  /* Next element in the same bucket - if any */
+  if (htbl->engine == CHTBL_SLIST)
+    {
+      if ((iter->node = SLISTnext(iter->node)) != NULL)
+        {
+          *data = SLISTdata(iter->node);
+          return 0;
+        }
+    }
+  else
+    {
+      next = iter->entry == 0 ? iter_flat(htbl, iter->bucket)->next : htbl->pool[iter->entry].next;
+
+      if (next != CHTBL_LAST)
+        {
+          iter->entry = next;
+          *data = htbl->pool[next].data;
+          return 0;
+        }
+    }
+
+  iter->bucket++;
+
+  return iter_seek(htbl, iter, end, data);
+}
+
+/* --- Function: static void *foreach_range(void *range) --- */
+static void *foreach_range(void *range)
+{
+  struct CHtblRange_ *rp = (struct CHtblRange_ *)range;
+  CHtblIter iter;
+  void *data;
+
+  iter.bucket = rp->from;
+
+  if (iter_seek(rp->htbl, &iter, rp->to, &data) == 0)
+    {
+      do
+        rp->callback(data, rp->arg);
+      while (iter_step(rp->htbl, &iter, rp->to, &data) == 0);
+    }
+
+  return NULL;
 }
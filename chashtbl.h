@@ -19,6 +19,13 @@
  *             in/out parameters - i.e. double-pointers.             
  * 2013-03-21  Minor documentation clarifications.
  * 2015-03-31  This code ready for version 0.51
+ * 2026-10-17  Added automatic resizing of the table - see CHTBLsetloadfactor(), CHTBLreserve()
+ *             and CHTBLbuckets().
+ * 2026-10-17  Added a flat, array-based storage engine - see CHTBLinit_ex().
+ * 2026-10-17  Added batch functions - CHTBLinsert_batch() and CHTBLlookup_batch().
+ * 2026-10-17  Added iteration - CHTBLfirst(), CHTBLnext() - and CHTBLforeach().
+ * 2026-10-17  Added CHTBLinsert_hash(), CHTBLremove_hash() and CHTBLlookup_hash() - for keys
+ *             already hashed by the caller.
  *
  */
 
@@ -39,6 +46,19 @@
 extern "C" {
 #endif
 
+  /**
+   * Macro for selecting the storage engine of the table - one
+   * @b Slist per bucket (=the default engine)
+   * 
+   **/
+#define CHTBL_SLIST 0
+  /**
+   * Macro for selecting the storage engine of the table - entries
+   * in contiguous arrays, with a cached hash value per entry
+   * 
+   **/
+#define CHTBL_FLAT 1
+
   /**
    * Use a @b typedef - to hide the interior of @b CHtbl_ - in the 
    * implementation file. This is how @a data @a hiding can be done in C.
@@ -46,12 +66,33 @@ extern "C" {
    **/
   typedef struct CHtbl_ *CHtbl;
 
+  /**
+   * A cursor - for iterating over all elements of a table
+   *
+   * Declare one - on the stack, for example - and pass a reference
+   * to it to @b CHTBLfirst() and @b CHTBLnext(). The members are
+   * private to the implementation.
+   *
+   **/
+  typedef struct CHtblIter_
+  {
+    int       bucket;  /* Current bucket - counting the new bucket array last, during a rehash */
+    int       entry;   /* CHTBL_FLAT - current overflow entry - or 0 for the 1st entry of the bucket */
+    SlistNode node;    /* CHTBL_SLIST - current node */
+    int       left;    /* Number of elements not visited yet */
+  } CHtblIter;
+
   /* FUNCTION DECLARATIONS */
 
 
   /**
    * Initiate the hash table
    * 
+   * The table is created with automatic resizing turned off - i.e.
+   * the number of buckets stays fixed, until resizing is enabled 
+   * by a call to @b CHTBLsetloadfactor(). Buckets are created on 
+   * demand, so a large number of buckets is cheap to set up.
+   *
    * @param[in] buckets - The number of buckets you want the
    * table to contain when created.
    * @param[in] h - A reference to a user-defined hash function. 
@@ -70,13 +111,48 @@ extern "C" {
    * as a parameter in subsequent calls - to the majority of other
    * table functions in this function interface - i.e. a sort
    * of "handle" to the table.
-   * @see CHTBLdestroy()
+   * @see CHTBLdestroy(), CHTBLinit_ex()
    **/
   CHtbl CHTBLinit(int buckets, 
                   int (*h)(const void *key),
                   int (*match)(const void *key1, const void *key2),
                   void (*destroy)(void *data));
 
+  /**
+   * Initiate the hash table - with a selectable storage engine
+   * 
+   * Works like @b CHTBLinit() - but lets you choose how the 
+   * elements are stored:
+   * - @b CHTBL_SLIST - every bucket is a singly-linked list (@b Slist),
+   * with one allocated node per element. Same as @b CHTBLinit().
+   * - @b CHTBL_FLAT - the first element of every bucket is stored 
+   * directly in the bucket array - collisions in an overflow array,
+   * linked by index. Each entry holds the data reference and its 
+   * cached hash value, so @a match is only called when the hash values
+   * agree - and no hash function calls are needed when the table is
+   * resized. A bucket scan touches a single cache line in the 
+   * common case, and there is no memory allocation per element.
+   *
+   * @param[in] buckets - The number of buckets you want the
+   * table to contain when created.
+   * @param[in] h - A reference to a user-defined hash function. 
+   * @param[in] match - A reference to a user-defined @a match 
+   * function.
+   * @param[in] destroy - A reference to a user-defined function,
+   * reponsible for freeing @a element @a data, when the table is 
+   * destroyed - or NULL.
+   * @param[in] engine - @b CHTBL_SLIST or @b CHTBL_FLAT.
+   * @return A reference - to a new, empty table - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise (also 
+   * returned for an unknown @a engine).
+   * @see CHTBLinit()
+   **/
+  CHtbl CHTBLinit_ex(int buckets, 
+                     int (*h)(const void *key),
+                     int (*match)(const void *key1, const void *key2),
+                     void (*destroy)(void *data),
+                     int engine);
+
   /**
    * Destroy the hash table
    * 
@@ -113,6 +189,27 @@ extern "C" {
    **/
   int CHTBLinsert(CHtbl htbl, const void *data);
 
+  /**
+   * Insert an array of data into the hash table
+   * 
+   * Works like calling @b CHTBLinsert() for each element of the 
+   * array @a data - in order. The keys are processed in small groups:
+   * all keys of a group are hashed, and their buckets are prefetched,
+   * before the insertions are done. This way, the cache misses of
+   * many keys overlap - instead of being taken one at a time.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] data - an array of @a n references to data, to
+   * be inserted into the table.
+   * @param[in] n - the number of elements in @a data.
+   * @param[out] results - an array of @a n return values - one per
+   * element, with the same meaning as the return value of
+   * @b CHTBLinsert() - or NULL, if not wanted.
+   * @return The number of elements actually inserted.
+   * @see CHTBLinsert()
+   **/
+  int CHTBLinsert_batch(CHtbl htbl, const void **data, int n, int *results);
+
   /**
    * Remove an element from the hash table
    * 
@@ -162,6 +259,8 @@ extern "C" {
    * by parameter @a data - must exist for this function to work.
    * This user-supplied @b match-callback was set when the hash
    * table was initialized - see CHTBLinit().
+   * A lookup never moves any buckets of an ongoing rehash - i.e.
+   * the table is left unmodified by this function.
    *
    * @param[in] htbl - a reference to current table.
    * @param[in,out] data - a reference to a pointer, pointing at
@@ -176,6 +275,67 @@ extern "C" {
    **/
   int CHTBLlookup(const CHtbl htbl, void **data);
 
+  /**
+   * Lookup an array of data in the table
+   * 
+   * Works like calling @b CHTBLlookup() for each element of the
+   * array @a data. The keys are processed in small groups: all keys
+   * of a group are hashed, and their buckets are prefetched, before
+   * the lookups are done - so the cache misses of many keys overlap.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in,out] data - an array of @a n pointers, pointing at
+   * the data to be searched for - at the call. Upon return - every
+   * pointer with a hit, has been redirected to point to data in the
+   * element hit. The other pointers are left untouched.
+   * @param[in] n - the number of elements in @a data.
+   * @param[out] results - an array of @a n return values - one per
+   * element, with the same meaning as the return value of
+   * @b CHTBLlookup() - or NULL, if not wanted.
+   * @return The number of elements found.
+   * @see CHTBLlookup()
+   **/
+  int CHTBLlookup_batch(const CHtbl htbl, void **data, int n, int *results);
+
+  /**
+   * Insert, remove and lookup - with a hash value already computed
+   *
+   * Work like @b CHTBLinsert(), @b CHTBLremove() and @b CHTBLlookup()
+   * - but use @a hashval, instead of calling the user-defined hash
+   * function. For containers built on top of the table - which hash
+   * the key themselves, e.g. to pick a shard - so that a key is
+   * hashed once only, per operation.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] hashval - the value returned by the hash function of
+   * the table - for the key of @a data. Any other value leaves the
+   * element in the wrong bucket.
+   * @param[in] data - see @b CHTBLinsert().
+   * @return See @b CHTBLinsert().
+   * @see CHTBLinsert(), CHTBLremove(), CHTBLlookup()
+   **/
+  int CHTBLinsert_hash(CHtbl htbl, int hashval, const void *data);
+
+  /**
+   * See @b CHTBLinsert_hash().
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] hashval - see @b CHTBLinsert_hash().
+   * @param[in,out] data - see @b CHTBLremove().
+   * @return See @b CHTBLremove().
+   **/
+  int CHTBLremove_hash(CHtbl htbl, int hashval, void **data);
+
+  /**
+   * See @b CHTBLinsert_hash().
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] hashval - see @b CHTBLinsert_hash().
+   * @param[in,out] data - see @b CHTBLlookup().
+   * @return See @b CHTBLlookup().
+   **/
+  int CHTBLlookup_hash(const CHtbl htbl, int hashval, void **data);
+
   /**
    * Get the number of elements in the table
    * 
@@ -186,6 +346,62 @@ extern "C" {
    **/
   int CHTBLsize(CHtbl htbl);
 
+  /**
+   * Get the number of buckets in the table
+   * 
+   * During an ongoing rehash - the number of buckets of the
+   * new bucket array is returned.
+   *
+   * @param[in] htbl - a reference to the current table.
+   *
+   * @return The number of buckets in the table.
+   **/
+  int CHTBLbuckets(CHtbl htbl);
+
+  /**
+   * Turn automatic resizing of the table on - or off
+   * 
+   * When the number of elements per bucket exceeds @a maxload - 
+   * after an insertion - the number of buckets is doubled. When
+   * it falls below @a minload - after a removal - the number of
+   * buckets is halved, but never below the number of buckets given
+   * to @b CHTBLinit() or @b CHTBLreserve().
+   * The elements are moved to the new bucket array @a incrementally -
+   * a few buckets on every call to @b CHTBLinsert() and
+   * @b CHTBLremove() - so no single call will stall on a rehash of 
+   * the whole table.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] maxload - max. load factor. A value <= 0 turns
+   * automatic resizing off (=default).
+   * @param[in] minload - min. load factor. Must be less than half 
+   * of @a maxload. A value of 0 means the table never shrinks.
+   *
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - if the load factors were out of range.
+   * @see CHTBLreserve()
+   **/
+  int CHTBLsetloadfactor(CHtbl htbl, double maxload, double minload);
+
+  /**
+   * Pre-size the table for a number of elements
+   * 
+   * Makes room for - at least - @a elements elements in the table,
+   * without exceeding the max. load factor set by 
+   * @b CHTBLsetloadfactor() - or 1 element per bucket, if automatic 
+   * resizing is turned off. If the table needs to grow - all
+   * elements are rehashed before this function returns. The table
+   * will not shrink below this size later on.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] elements - the number of elements to make room for.
+   *
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise (implies fatal error).
+   * @see CHTBLsetloadfactor()
+   **/
+  int CHTBLreserve(CHtbl htbl, int elements);
+
   /**
    * Print all data within the table - on screen
    * 
@@ -202,6 +418,67 @@ extern "C" {
    **/
   void CHTBLprint(CHtbl htbl, void (*callback)(const void *data));
 
+  /**
+   * Get the first element of the table - when iterating
+   *
+   * Starts an iteration over all elements of the table - in no
+   * particular order. Empty buckets are skipped - and the iteration
+   * ends as soon as the last element has been visited, without
+   * scanning the remaining buckets. The table must not be modified
+   * - by @b CHTBLinsert(), @b CHTBLremove(), or any other function
+   * that may resize it - until the iteration is finished.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[out] iter - a reference to a cursor - set up by this call,
+   * for subsequent calls to @b CHTBLnext().
+   * @param[out] data - a reference to a pointer - redirected to the
+   * data of the first element, upon return.
+   *
+   * @return Value 0 - if an element was found.\n
+   *         Value -1 - if the table is empty.
+   * @see CHTBLnext()
+   **/
+  int CHTBLfirst(CHtbl htbl, CHtblIter *iter, void **data);
+
+  /**
+   * Get the next element of the table - when iterating
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in,out] iter - a reference to a cursor - set up by
+   * @b CHTBLfirst().
+   * @param[out] data - a reference to a pointer - redirected to the
+   * data of the next element, upon return.
+   *
+   * @return Value 0 - if an element was found.\n
+   *         Value -1 - if all elements have been visited.
+   * @see CHTBLfirst()
+   **/
+  int CHTBLnext(CHtbl htbl, CHtblIter *iter, void **data);
+
+  /**
+   * Visit all elements of the table - in parallel
+   *
+   * The buckets are split into @a nthreads ranges of equal size -
+   * each one scanned by a thread of its own, calling @a callback for
+   * every element in the range. The calling thread scans one of the
+   * ranges itself - and this function returns when all of them are
+   * done. The table must not be modified during the call, and the
+   * callback must be thread-safe. On platforms without POSIX threads
+   * - or if a thread cannot be started - the ranges are scanned by
+   * the calling thread.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] callback - reference to a user-defined function, called
+   * with the data of each element - and @a arg.
+   * @param[in] arg - passed on to @a callback - untouched.
+   * @param[in] nthreads - the number of threads to use. A value less
+   * than 2 scans the table in the calling thread only.
+   *
+   * @return Nothing.
+   * @see CHTBLfirst()
+   **/
+  void CHTBLforeach(CHtbl htbl, void (*callback)(void *data, void *arg), void *arg, int nthreads);
+
 
 #ifdef __cplusplus
 }
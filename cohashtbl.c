@@ -0,0 +1,559 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: cohashtbl.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 12:20:05 2026
+ * Version : 0.51
+ * ---
+ * Description: A concurrent, open-addressed hashtable with lock-free lookups - implemented
+ *              as a pure, generic ADT, on top of POSIX threads and atomic operations.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ * 261017 COHTBLpositions() now reads the table inside a read-side section.
+ * 261017 COHTBLinit() now fails for a NULL hash - or match - function.
+ *
+ */
+/**
+ * @file cohashtbl.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "cohashtbl.h"
+#include "allocator.h"
+
+#if !defined(__GNUC__)
+#error "cohashtbl.c needs the __atomic builtins of GCC (or Clang)"
+#endif
+
+/* Atomic access to data shared with lock-free readers */
+#define COHTBL_LOAD(ptr)         __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define COHTBL_STORE(ptr, val)   __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define COHTBL_LOAD_SC(ptr)      __atomic_load_n(ptr, __ATOMIC_SEQ_CST)
+#define COHTBL_STORE_SC(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_SEQ_CST)
+
+/* Size of a cache line - the reader counters are padded to this size */
+#define COHTBL_CACHELINE 64
+
+/* Number of reader counters - per epoch. Readers spread over them by stack address */
+#define COHTBL_STRIPES 32
+
+/* Number of retired elements - collected before they are reclaimed together */
+#define COHTBL_RETIRE_BATCH 64
+
+/* Max. load factor - counting vacated positions too */
+#define COHTBL_MAXLOAD 0.5
+
+/* A table of positions - replaced, as a whole, when the table grows */
+struct COHtblTable_
+{
+  int  positions;
+  void **slots;
+};
+
+/* A reader counter - alone on its cache line */
+typedef union COHtblCounter_
+{
+  long count;
+  char pad[COHTBL_CACHELINE];
+} COHtblCounter;
+
+struct COHtbl_
+{
+  struct COHtblTable_ *table; /* Read by lock-free readers - replaced atomically */
+  void      *vacated;
+
+  int       (*h1)(const void *key);
+  int       (*h2)(const void *key);
+  int       (*match)(const void *key1, const void *key2);
+  void      (*destroy)(void *data);
+
+  int       size;
+  int       vacancies;
+
+  pthread_mutex_t wlock;  /* Serializes all writers */
+
+  unsigned long epoch;    /* Readers register in the counters of epoch parity */
+  COHtblCounter readers[2][COHTBL_STRIPES];
+
+  void      **retired;    /* Removed - but maybe still referenced - element data */
+  int       nretired;
+  int       maxretired;
+  const Allocator *alloc;
+};
+
+/* Reserve a sentinel memory address for vacated elements */
+static char vacated;
+
+/* STATIC FUNCTION DECLARATIONS */
+static struct COHtblTable_ *alloc_table(COHtbl htbl, int positions);
+static int probe(COHtbl htbl, struct COHtblTable_ *table, const void *key, int *freepos, void **hit);
+static int grow(COHtbl htbl);
+static void synchronize(COHtbl htbl);
+static void reclaim(COHtbl htbl);
+static int retire(COHtbl htbl, void *data);
+static int next_prime(int n);
+
+/* FUNCTION DEFINITIONS */
+
+COHtbl COHTBLinit(int positions, int (*h1)(const void *key), int (*h2)(const void *key),
+                  int (*match)(const void *key1, const void *key2), void (*destroy)(void *data))
+{
+  COHtbl htbl;
+  const Allocator *alloc = ALLOCATORget();
+  int i;
+
+  /* Every probe calls both hash functions - and the match function */
+  if (h1 == NULL || h2 == NULL || match == NULL)
+    return NULL;
+
+  /* Allocate space for the hash table header */
+  if ((htbl = ALLOCATOR_MALLOC(alloc, sizeof(struct COHtbl_))) == NULL)
+    return NULL;
+
+  htbl->alloc = alloc;
+
+  if ((htbl->table = alloc_table(htbl, positions < 2 ? 2 : positions)) == NULL)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl);
+      return NULL;
+    }
+
+  if (pthread_mutex_init(&htbl->wlock, NULL) != 0)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl->table->slots);
+      ALLOCATOR_FREE(htbl->alloc, htbl->table);
+      ALLOCATOR_FREE(htbl->alloc, htbl);
+      return NULL;
+    }
+
+  /* Set the vacated member to the sentinel memory address reserved for this */
+  htbl->vacated = &vacated;
+
+  /* Encapsulate the functions */
+  htbl->h1 = h1;
+  htbl->h2 = h2;
+  htbl->match = match;
+  htbl->destroy = destroy;
+
+  /* Initialize the number of elements in the table */
+  htbl->size = 0;
+  htbl->vacancies = 0;
+
+  /* No readers - nothing retired */
+  htbl->epoch = 0;
+
+  for (i = 0; i < COHTBL_STRIPES; i++)
+    {
+      htbl->readers[0][i].count = 0;
+      htbl->readers[1][i].count = 0;
+    }
+
+  htbl->retired = NULL;
+  htbl->nretired = 0;
+  htbl->maxretired = 0;
+
+  return htbl;
+}
+
+void COHTBLdestroy(COHtbl htbl)
+{
+  struct COHtblTable_ *table = htbl->table;
+  int i;
+
+  if (htbl->destroy != NULL)
+    {
+      /* Call a user-defined function to free dynamically allocated data */
+      for (i = 0; i < table->positions; i++)
+        {
+          if (table->slots[i] != NULL && table->slots[i] != htbl->vacated)
+            htbl->destroy(table->slots[i]);
+        }
+
+      for (i = 0; i < htbl->nretired; i++)
+        htbl->destroy(htbl->retired[i]);
+    }
+
+  /* Free the storage allocated for the hash table */
+  ALLOCATOR_FREE(htbl->alloc, table->slots);
+  ALLOCATOR_FREE(htbl->alloc, table);
+  ALLOCATOR_FREE(htbl->alloc, htbl->retired);
+  pthread_mutex_destroy(&htbl->wlock);
+
+  /* Free the storage allocated for the table header */
+  ALLOCATOR_FREE(htbl->alloc, htbl);
+}
+
+int COHTBLinsert(COHtbl htbl, const void *data)
+{
+  int freepos, retval = 0;
+  void *hit;
+
+  pthread_mutex_lock(&htbl->wlock);
+
+  /* Grow - or purge vacated positions - before the max. load factor is exceeded */
+  if (htbl->size + htbl->vacancies + 1 > COHTBL_MAXLOAD * htbl->table->positions)
+    grow(htbl);
+
+  /* Do nothing if the data is already in the table */
+  if (probe(htbl, htbl->table, data, &freepos, &hit) >= 0) /* Duplicate found! */
+    retval = 1;
+  else if (freepos < 0)
+    {
+      /* Table full - or the hash functions were selected incorrectly */
+      retval = -1;
+    }
+  else
+    {
+      if (htbl->table->slots[freepos] == htbl->vacated)
+        htbl->vacancies--;
+
+      /* Publish the data - readers see it completely initialized */
+      COHTBL_STORE(&htbl->table->slots[freepos], (void *)data);
+      __atomic_store_n(&htbl->size, htbl->size + 1, __ATOMIC_RELAXED);
+    }
+
+  pthread_mutex_unlock(&htbl->wlock);
+
+  return retval;
+}
+
+int COHTBLremove(COHtbl htbl, void **data)
+{
+  int position, freepos;
+
+  pthread_mutex_lock(&htbl->wlock);
+
+  if ((position = probe(htbl, htbl->table, *data, &freepos, data)) < 0)
+    {
+      pthread_mutex_unlock(&htbl->wlock);
+
+      /* Return that the data was not found */
+      return -1;
+    }
+
+  /* Readers passing this position carry on probing beyond it */
+  COHTBL_STORE(&htbl->table->slots[position], htbl->vacated);
+  htbl->vacancies++;
+  __atomic_store_n(&htbl->size, htbl->size - 1, __ATOMIC_RELAXED);
+
+  /* Let the data be freed - when no reader can reach it any longer */
+  if (htbl->destroy != NULL && retire(htbl, *data) != 0)
+    {
+      synchronize(htbl);
+      htbl->destroy(*data);
+    }
+
+  pthread_mutex_unlock(&htbl->wlock);
+
+  return 0;
+}
+
+int COHTBLlookup(const COHtbl htbl, void **data)
+{
+  struct COHtblTable_ *table;
+  int token, position, freepos;
+
+  token = COHTBLenter(htbl);
+
+  /* The table - and all element data reachable from it - stays allocated until
+     this read-side section is left */
+  table = COHTBL_LOAD_SC(&htbl->table);
+
+  position = probe(htbl, table, *data, &freepos, data);
+
+  COHTBLleave(htbl, token);
+
+  /* Return that the data was not found - or found, and passed back */
+  return position < 0 ? -1 : 0;
+}
+
+int COHTBLenter(COHtbl htbl)
+{
+  unsigned long epoch;
+  int stripe;
+  char here;
+
+  /* Spread threads over the counters - by (a hash of) the stack page they run on */
+  stripe = (int)((((unsigned int)((size_t)&here >> 12) * 2654435761U) >> 16) % COHTBL_STRIPES);
+
+  for (;;)
+    {
+      epoch = COHTBL_LOAD_SC(&htbl->epoch);
+      __atomic_fetch_add(&htbl->readers[epoch & 1][stripe].count, 1, __ATOMIC_SEQ_CST);
+
+      /* Registered in the current epoch - unless a writer flipped it meanwhile */
+      if (COHTBL_LOAD_SC(&htbl->epoch) == epoch)
+        return (int)(epoch & 1) * COHTBL_STRIPES + stripe;
+
+      __atomic_fetch_sub(&htbl->readers[epoch & 1][stripe].count, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+void COHTBLleave(COHtbl htbl, int token)
+{
+  __atomic_fetch_sub(&htbl->readers[token / COHTBL_STRIPES][token % COHTBL_STRIPES].count, 1, __ATOMIC_RELEASE);
+}
+
+void COHTBLsynchronize(COHtbl htbl)
+{
+  pthread_mutex_lock(&htbl->wlock);
+  reclaim(htbl);
+  pthread_mutex_unlock(&htbl->wlock);
+}
+
+int COHTBLsize(COHtbl htbl)
+{
+  return __atomic_load_n(&htbl->size, __ATOMIC_RELAXED);
+}
+
+int COHTBLpositions(COHtbl htbl)
+{
+  int token, positions;
+
+  /* The table may be replaced - and freed - by a concurrent grow */
+  token = COHTBLenter(htbl);
+  positions = COHTBL_LOAD_SC(&htbl->table)->positions;
+  COHTBLleave(htbl, token);
+
+  return positions;
+}
+
+void COHTBLprint(COHtbl htbl, void (*callback)(const void *data))
+{
+  int i;
+
+  pthread_mutex_lock(&htbl->wlock);
+
+  for (i=0; i<htbl->table->positions; i++)
+    {
+      if (htbl->table->slots[i] == NULL)
+        printf("\nNULL");
+      else if (htbl->table->slots[i] == htbl->vacated)
+        printf("\nVACATED");
+      else
+        callback(htbl->table->slots[i]);
+    }
+
+  pthread_mutex_unlock(&htbl->wlock);
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static struct COHtblTable_ *alloc_table(COHtbl htbl, int positions) --- */
+static struct COHtblTable_ *alloc_table(COHtbl htbl, int positions)
+{
+  struct COHtblTable_ *table;
+  int i;
+
+  if ((table = ALLOCATOR_MALLOC(htbl->alloc, sizeof(struct COHtblTable_))) == NULL)
+    return NULL;
+
+  if ((table->slots = (void **)ALLOCATOR_MALLOC(htbl->alloc, positions * sizeof(void *))) == NULL)
+    {
+      ALLOCATOR_FREE(htbl->alloc, table);
+      return NULL;
+    }
+
+  for (i = 0; i < positions; i++)
+    table->slots[i] = NULL;
+
+  table->positions = positions;
+
+  return table;
+}
+
+/* --- Function: static int probe(COHtbl htbl, struct COHtblTable_ *table, const void *key, int *freepos, void **hit) --- */
+static int probe(COHtbl htbl, struct COHtblTable_ *table, const void *key, int *freepos, void **hit)
+{
+  unsigned int position, step;
+  void *data;
+  int i;
+
+  /* Use double hashing - position = (h1 + i*h2) % positions - computed incrementally */
+  position = (unsigned int)htbl->h1(key) % (unsigned int)table->positions;
+  step = (unsigned int)htbl->h2(key) % (unsigned int)table->positions;
+  *freepos = -1;
+
+  /* A step of zero would probe the same position over and over again */
+  if (step == 0)
+    step = 1;
+
+  for (i = 0; i < table->positions; i++)
+    {
+      /* Every position is read once only - a writer may change it at any time */
+      data = COHTBL_LOAD(&table->slots[position]);
+
+      if (data == NULL)
+        {
+          /* Data not found - first free position is here - unless a vacated one came before */
+          if (*freepos < 0)
+            *freepos = (int)position;
+          return -1;
+        }
+      else if (data == htbl->vacated)
+        {
+          /* Remember the first vacated position - and search beyond it */
+          if (*freepos < 0)
+            *freepos = (int)position;
+        }
+      else if (htbl->match(data, key))
+        {
+          /* Pass back the data matched - the position may be vacated at any time */
+          *hit = data;
+          return (int)position;
+        }
+
+      position = (position + step) % (unsigned int)table->positions;
+    }
+
+  /* Data not found... */
+  return -1;
+}
+
+/* --- Function: static int grow(COHtbl htbl) --- */
+static int grow(COHtbl htbl)
+{
+  struct COHtblTable_ *oldtable, *table;
+  unsigned int position, step;
+  void *data;
+  int positions, i, j;
+
+  oldtable = htbl->table;
+
+  /* Mostly vacated positions - a rehash at the current size is enough. Otherwise -
+     a prime number of positions keeps all double hashing step sizes usable */
+  if (htbl->size + 1 <= COHTBL_MAXLOAD * oldtable->positions / 2)
+    positions = oldtable->positions;
+  else
+    positions = next_prime(2 * oldtable->positions);
+
+  if ((table = alloc_table(htbl, positions)) == NULL)
+    return -1;
+
+  /* Reinsert all elements into the new - still private - table */
+  for (i = 0; i < oldtable->positions; i++)
+    {
+      data = oldtable->slots[i];
+
+      if (data == NULL || data == htbl->vacated)
+        continue;
+
+      position = (unsigned int)htbl->h1(data) % (unsigned int)positions;
+      step = (unsigned int)htbl->h2(data) % (unsigned int)positions;
+
+      if (step == 0)
+        step = 1;
+
+      for (j = 0; j < positions && table->slots[position] != NULL; j++)
+        position = (position + step) % (unsigned int)positions;
+
+      if (j == positions)
+        {
+          /* No free position in the probe sequence - keep the old table */
+          ALLOCATOR_FREE(htbl->alloc, table->slots);
+          ALLOCATOR_FREE(htbl->alloc, table);
+          return -1;
+        }
+
+      table->slots[position] = data;
+    }
+
+  /* Publish the new table - then wait for readers of the old one, before freeing it */
+  COHTBL_STORE_SC(&htbl->table, table);
+  htbl->vacancies = 0;
+
+  reclaim(htbl);
+
+  ALLOCATOR_FREE(htbl->alloc, oldtable->slots);
+  ALLOCATOR_FREE(htbl->alloc, oldtable);
+
+  return 0;
+}
+
+/* --- Function: static void synchronize(COHtbl htbl) --- */
+static void synchronize(COHtbl htbl)
+{
+  unsigned long epoch;
+  int i;
+
+  /* Called with the writer lock held - so this is the only thread flipping the epoch */
+  epoch = htbl->epoch;
+  COHTBL_STORE_SC(&htbl->epoch, epoch + 1);
+
+  /* New readers register in the other epoch. Wait for the ones of the old epoch */
+  for (i = 0; i < COHTBL_STRIPES; i++)
+    {
+      while (COHTBL_LOAD_SC(&htbl->readers[epoch & 1][i].count) != 0)
+        sched_yield();
+    }
+}
+
+/* --- Function: static void reclaim(COHtbl htbl) --- */
+static void reclaim(COHtbl htbl)
+{
+  int i;
+
+  synchronize(htbl);
+
+  /* No reader can reach the retired data any longer */
+  for (i = 0; i < htbl->nretired; i++)
+    htbl->destroy(htbl->retired[i]);
+
+  htbl->nretired = 0;
+}
+
+/* --- Function: static int retire(COHtbl htbl, void *data) --- */
+static int retire(COHtbl htbl, void *data)
+{
+  void **retired;
+
+  if (htbl->nretired == htbl->maxretired)
+    {
+      if ((retired = (void **)ALLOCATOR_REALLOC(htbl->alloc, htbl->retired, (htbl->maxretired + COHTBL_RETIRE_BATCH) * sizeof(void *))) == NULL)
+        return -1;
+
+      htbl->retired = retired;
+      htbl->maxretired += COHTBL_RETIRE_BATCH;
+    }
+
+  htbl->retired[htbl->nretired++] = data;
+
+  /* One grace period - for a whole batch of retired data */
+  if (htbl->nretired >= COHTBL_RETIRE_BATCH)
+    reclaim(htbl);
+
+  return 0;
+}
+
+/* --- Function: static int next_prime(int n) --- */
+static int next_prime(int n)
+{
+  int i;
+
+  if (n <= 2)
+    return 2;
+
+  if (n % 2 == 0)
+    n++;
+
+  for (;; n += 2)
+    {
+      for (i = 3; i <= n / i; i += 2)
+        {
+          if (n % i == 0)
+            break;
+        }
+
+      if (i > n / i)
+        return n;
+    }
+}
@@ -0,0 +1,241 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: cohashtbl.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 12:20:05 2026
+ * Version : 0.51
+ * ---
+ * Description: A concurrent, open-addressed hashtable with lock-free lookups - implemented
+ *              as a pure, generic ADT, on top of POSIX threads and atomic operations.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 COHTBLinit() now returns NULL for a NULL hash - or match - function.
+ * 261017 Stated the platform requirements - see below.
+ *
+ */
+/**
+ * @file cohashtbl.h
+ *
+ * This module needs POSIX threads - and the @b __atomic builtins of
+ * GCC (or Clang). It does not compile with other compilers - e.g.
+ * MSVC - and is left out of the Windows makefiles (vcwin32.mak,
+ * mingw32.mak and msys32.mak).
+ **/
+
+
+#ifndef _COHASHTBL_H_
+#define _COHASHTBL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Use a @b typedef - to hide the interior of @b COHtbl_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct COHtbl_ *COHtbl;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Initialize the concurrent open-addressed hash table
+   *
+   * Works like @b OHTBLinit() - with double hashing - but all functions
+   * of this interface may be called concurrently from different threads
+   * (except @b COHTBLinit() and @b COHTBLdestroy()). Lookups take no
+   * locks at all - they read the table with atomic loads only. Writers
+   * - i.e. @b COHTBLinsert() and @b COHTBLremove() - are serialized by
+   * a lock. The table grows automatically, at a load factor of 1/2.
+   *
+   * Removed elements - and the old table, after growing - are not
+   * freed at once, since a concurrent lookup may still be looking at
+   * them. They are @a retired, and freed first when every lookup - or
+   * read-side section, see @b COHTBLenter() - that was in progress at
+   * the time of retirement has finished (=epoch based reclamation).
+   *
+   * @param[in] positions - The initial number of positions in the table.
+   * @param[in] h1 - A reference to the 1st user-defined hash function.
+   * It must be thread-safe.
+   * @param[in] h2 - A reference to the 2nd user-defined hash function.
+   * It must be thread-safe.
+   * @param[in] match - A reference to a user-defined @a match
+   * function. This function shall return 1 - if @a key1 is equal
+   * to @a key2 - or 0 otherwise. It must be thread-safe.
+   * @param[in] destroy - A reference to a user-defined function,
+   * reponsible for freeing @a element @a data. It is called for
+   * retired elements, when they can no longer be reached by any
+   * reader - and for all remaining elements, when the table is
+   * destroyed. If @a destroy is set to NULL - element data will be
+   * left untouched - see @b COHTBLremove().
+   * @return A reference - to a new, empty table - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise (also
+   * returned if @a h1, @a h2 or @a match is NULL). Take
+   * really good care of this return value, since it will be needed
+   * as a parameter in subsequent calls - to the majority of other
+   * table functions in this function interface - i.e. a sort
+   * of "handle" to the table.
+   * @see COHTBLdestroy()
+   **/
+  COHtbl COHTBLinit(int positions, int (*h1)(const void *key), int (*h2)(const void *key),
+                    int (*match)(const void *key1, const void *key2), void (*destroy)(void *data));
+
+  /**
+   * Destroy the concurrent hash table
+   *
+   * All remaining - and all retired - elements are handed over to
+   * @a destroy, if set, and the table is freed. No other thread may
+   * access the table during - or after - this call.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @return Nothing.
+   * @see COHTBLinit()
+   **/
+  void COHTBLdestroy(COHtbl htbl);
+
+  /**
+   * Insert a data element into the table
+   *
+   * The element becomes visible to concurrent lookups - fully
+   * initialized - as soon as it is stored in the table.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] data - a reference to data to be inserted into
+   * the table.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value 1 - if the element is already present in the table\n
+   *         Value -1 - otherwise (implies fatal error).
+   **/
+  int COHTBLinsert(COHtbl htbl, const void *data);
+
+  /**
+   * Remove a data element from the table
+   *
+   * When called, the 2nd parameter of this function, @a data,
+   * should reference an (external, user-defined) pointer, that
+   * points to the search key data. After the call - this referenced,
+   * external pointer has been redirected by this function, to point
+   * to the data of the removed element - if the call was succesful.
+   *
+   * Concurrent lookups may still hold a reference to the removed
+   * element data. If @a destroy was set by @b COHTBLinit() - the data
+   * is retired, and freed by @a destroy later on - so the caller must
+   * @b not free it. Otherwise the caller is responsible for the data,
+   * and must call @b COHTBLsynchronize() before freeing it.
+   *
+   * @param[in] htbl - reference to current table.
+   * @param[in,out] data - reference to a pointer, pointing at the
+   * search key data - at the call - and at the removed data, upon
+   * return.
+   *
+   * @return Value 0 --  if the call was OK - that is, element
+   * found and removed.\n
+   *         Value -1 --  node not found.\n
+   **/
+  int COHTBLremove(COHtbl htbl, void **data);
+
+  /**
+   * Determine if a data element exists in the table - without locking
+   *
+   * Works like @b OHTBLlookup(). Element data passed back stays valid
+   * until the end of the read-side section - see @b COHTBLenter() - the
+   * call was made in. Outside of such a section - the data may be
+   * removed and freed by another thread at any time after the call.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in,out] data - a reference to a pointer, pointing at
+   * the data to be searched for - at the call. Upon return - this
+   * pointer has been redirected by this function - and points
+   * instead to data in the element hit - if any.
+   *
+   * @return Value 0 - if element with matching data was found.\n
+   *         Value -1 - otherwise.
+   **/
+  int COHTBLlookup(const COHtbl htbl, void **data);
+
+  /**
+   * Enter a read-side section
+   *
+   * No element data - found by @b COHTBLlookup() inside the section -
+   * is freed until the section is left by @b COHTBLleave(). Sections
+   * may be nested, but should be kept short - since they hold back
+   * the reclamation of removed elements - and must never contain a
+   * call to @b COHTBLsynchronize(), @b COHTBLinsert() or
+   * @b COHTBLremove() - by the same thread.
+   *
+   * @param[in] htbl - a reference to current table.
+   *
+   * @return A token - to be passed to @b COHTBLleave().
+   **/
+  int COHTBLenter(COHtbl htbl);
+
+  /**
+   * Leave a read-side section
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] token - the token returned by the matching call to
+   * @b COHTBLenter().
+   *
+   * @return Nothing.
+   **/
+  void COHTBLleave(COHtbl htbl, int token);
+
+  /**
+   * Wait for all read-side sections in progress to finish
+   *
+   * When this function returns - no reader can reference an element
+   * removed before the call. All retired elements are freed.
+   *
+   * @param[in] htbl - a reference to current table.
+   *
+   * @return Nothing.
+   **/
+  void COHTBLsynchronize(COHtbl htbl);
+
+  /**
+   * Get the size of the table
+   *
+   * @param[in] htbl - a reference to the current table.
+   *
+   * @return The size, that is, the number of elements
+   * in the table.
+   **/
+  int COHTBLsize(COHtbl htbl);
+
+  /**
+   * Get the number of positions of the table
+   *
+   * @param[in] htbl - a reference to the current table.
+   *
+   * @return The current number of positions in the table.
+   **/
+  int COHTBLpositions(COHtbl htbl);
+
+  /**
+   * Print all data of the hash table - on screen
+   *
+   * Works like @b OHTBLprint(). Writers are held back during the call.
+   *
+   * @param[in] htbl - reference to current table.
+   * @param[in] callback - reference to user-defined callback function,
+   * that gets @b read @b access to element data via its parameter
+   * @a data - to do whatever is relevant.
+   *
+   * @return - Nothing.
+   **/
+  void COHTBLprint(COHtbl htbl, void (*callback)(const void *data));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _COHASHTBL_H_ */
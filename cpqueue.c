@@ -0,0 +1,336 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: cpqueue.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 16:31:40 2026
+ * Version : 0.51
+ * ---
+ * Description: A concurrent priority queue - a "MultiQueue" of locked heaps - implemented
+ *              as a pure, generic ADT, on top of Heap and POSIX threads.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ *
+ */
+
+/**
+ * @file cpqueue.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "cpqueue.h"
+#include "allocator.h"
+
+#if !defined(__GNUC__)
+#error "cpqueue.c needs the __atomic builtins - and thread-local storage - of GCC (or Clang)"
+#endif
+
+/**
+ * Macro for the size of a cache line
+ *
+ * Every heap - i.e. its lock and heap reference - is padded and
+ * aligned to this size, so that threads working on different
+ * heaps do not share (and bounce) cache lines between cores.
+ **/
+#define CPQUEUE_CACHELINE 64
+
+/**
+ * Macro for the number of random picks - before giving up on finding an unlocked heap
+ *
+ * Insertion then waits for the lock of the last heap picked.
+ * Extraction then scans all heaps, one by one.
+ **/
+#define CPQUEUE_TRIES 8
+
+struct CPQueueShard_
+{
+  pthread_mutex_t lock;
+  Heap            heap;
+};
+
+/* A shard - padded to a whole number of cache lines */
+typedef union CPQueueSlot_
+{
+  struct CPQueueShard_ shard;
+  char pad[CPQUEUE_CACHELINE * ((sizeof(struct CPQueueShard_) + CPQUEUE_CACHELINE - 1) / CPQUEUE_CACHELINE)];
+} CPQueueSlot;
+
+struct CPQueue_
+{
+  int         queues;
+  int         (*compare)(const void *key1, const void *key2);
+  int         size;      /* Updated atomically */
+  CPQueueSlot *slots;    /* Aligned to a cache line - within 'mem' */
+  void        *mem;
+  const Allocator *alloc;
+};
+
+/* The state of the random number generator - of each thread */
+static __thread unsigned int seed;
+
+/* Number of threads - that have seeded their generator */
+static unsigned int seeded;
+
+/* STATIC FUNCTION DECLARATIONS */
+static unsigned int rnd(void);
+
+/* FUNCTION DEFINITIONS */
+
+CPQueue CPQUEUEinit(int queues, int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data))
+{
+  CPQueue cpq;
+  const Allocator *alloc = ALLOCATORget();
+  int i;
+
+  if (queues < 1)
+    return NULL;
+
+  if ((cpq = (CPQueue)ALLOCATOR_MALLOC(alloc, sizeof(struct CPQueue_)))==NULL)
+    return NULL;
+
+  cpq->alloc = alloc;
+
+  if ((cpq->mem = ALLOCATOR_MALLOC(cpq->alloc, queues * sizeof(CPQueueSlot) + CPQUEUE_CACHELINE)) == NULL)
+    {
+      ALLOCATOR_FREE(cpq->alloc, cpq);
+      return NULL;
+    }
+
+  cpq->slots = (CPQueueSlot *)(((size_t)cpq->mem + CPQUEUE_CACHELINE - 1) & ~(size_t)(CPQUEUE_CACHELINE - 1));
+  cpq->queues = queues;
+  cpq->compare = compare;
+  cpq->size = 0;
+
+  for (i = 0; i < queues; i++)
+    {
+      struct CPQueueShard_ *shard = &cpq->slots[i].shard;
+
+      if ((shard->heap = HEAPinit(compare, destroy)) == NULL)
+        break;
+
+      if (pthread_mutex_init(&shard->lock, NULL) != 0)
+        {
+          HEAPdestroy(shard->heap);
+          break;
+        }
+    }
+
+  /* Undo what has been set up - on failure */
+  if (i < queues)
+    {
+      while (i--)
+        {
+          pthread_mutex_destroy(&cpq->slots[i].shard.lock);
+          HEAPdestroy(cpq->slots[i].shard.heap);
+        }
+
+      ALLOCATOR_FREE(cpq->alloc, cpq->mem);
+      ALLOCATOR_FREE(cpq->alloc, cpq);
+      return NULL;
+    }
+
+  return cpq;
+}
+
+void CPQUEUEdestroy(CPQueue cpq)
+{
+  int i;
+
+  for (i = 0; i < cpq->queues; i++)
+    {
+      HEAPdestroy(cpq->slots[i].shard.heap);
+      pthread_mutex_destroy(&cpq->slots[i].shard.lock);
+    }
+
+  ALLOCATOR_FREE(cpq->alloc, cpq->mem);
+  ALLOCATOR_FREE(cpq->alloc, cpq);
+}
+
+int CPQUEUEinsert(CPQueue cpq, const void *data)
+{
+  struct CPQueueShard_ *shard;
+  int tries, retval;
+
+  /* Pick heaps at random - until one is found unlocked */
+  for (tries = 1; ; tries++)
+    {
+      shard = &cpq->slots[rnd() % (unsigned int)cpq->queues].shard;
+
+      if (pthread_mutex_trylock(&shard->lock) == 0)
+        break;
+
+      if (tries == CPQUEUE_TRIES)
+        {
+          pthread_mutex_lock(&shard->lock);
+          break;
+        }
+    }
+
+  /* Count the element while the heap is locked - so the size never drops below 0 */
+  if ((retval = HEAPinsert(shard->heap, data)) == 0)
+    __atomic_fetch_add(&cpq->size, 1, __ATOMIC_RELAXED);
+
+  pthread_mutex_unlock(&shard->lock);
+
+  return retval;
+}
+
+int CPQUEUEextract(CPQueue cpq, void **data)
+{
+  struct CPQueueShard_ *a, *b, *best;
+  int tries, i;
+
+  for (tries = 0; tries < CPQUEUE_TRIES; tries++)
+    {
+      if (__atomic_load_n(&cpq->size, __ATOMIC_RELAXED) == 0)
+        return -1;
+
+      /* Two different heaps - at random. Heaps locked by other threads are skipped */
+      i = (int)(rnd() % (unsigned int)cpq->queues);
+      a = &cpq->slots[i].shard;
+      b = NULL;
+
+      if (cpq->queues > 1)
+        b = &cpq->slots[(i + 1 + (int)(rnd() % (unsigned int)(cpq->queues - 1))) % cpq->queues].shard;
+
+      if (pthread_mutex_trylock(&a->lock) != 0)
+        a = NULL;
+
+      if (b != NULL && pthread_mutex_trylock(&b->lock) != 0)
+        b = NULL;
+
+      /* Take the top of higher priority - of the two */
+      best = a != NULL && HEAPsize(a->heap) > 0 ? a : NULL;
+
+      if (b != NULL && HEAPsize(b->heap) > 0)
+        {
+          if (best == NULL || cpq->compare(HEAPpeek(b->heap), HEAPpeek(best->heap)) > 0)
+            best = b;
+        }
+
+      if (best != NULL)
+        HEAPextract(best->heap, data);
+
+      if (a != NULL)
+        pthread_mutex_unlock(&a->lock);
+
+      if (b != NULL)
+        pthread_mutex_unlock(&b->lock);
+
+      if (best != NULL)
+        {
+          __atomic_fetch_sub(&cpq->size, 1, __ATOMIC_RELAXED);
+          return 0;
+        }
+    }
+
+  /* Few elements - or much contention. Look into every heap, waiting for its lock */
+  for (i = 0; i < cpq->queues; i++)
+    {
+      a = &cpq->slots[i].shard;
+
+      pthread_mutex_lock(&a->lock);
+
+      if (HEAPsize(a->heap) > 0)
+        {
+          HEAPextract(a->heap, data);
+          pthread_mutex_unlock(&a->lock);
+          __atomic_fetch_sub(&cpq->size, 1, __ATOMIC_RELAXED);
+          return 0;
+        }
+
+      pthread_mutex_unlock(&a->lock);
+    }
+
+  return -1;
+}
+
+int CPQUEUEextract_strict(CPQueue cpq, void **data)
+{
+  struct CPQueueShard_ *shard, *best = NULL;
+  int i;
+
+  /* Lock all heaps - always in the same order, so no two threads deadlock */
+  for (i = 0; i < cpq->queues; i++)
+    {
+      shard = &cpq->slots[i].shard;
+
+      pthread_mutex_lock(&shard->lock);
+
+      if (HEAPsize(shard->heap) > 0)
+        {
+          if (best == NULL || cpq->compare(HEAPpeek(shard->heap), HEAPpeek(best->heap)) > 0)
+            best = shard;
+        }
+    }
+
+  if (best != NULL)
+    HEAPextract(best->heap, data);
+
+  for (i = 0; i < cpq->queues; i++)
+    pthread_mutex_unlock(&cpq->slots[i].shard.lock);
+
+  if (best == NULL)
+    return -1;
+
+  __atomic_fetch_sub(&cpq->size, 1, __ATOMIC_RELAXED);
+
+  return 0;
+}
+
+int CPQUEUEsize(CPQueue cpq)
+{
+  return __atomic_load_n(&cpq->size, __ATOMIC_RELAXED);
+}
+
+int CPQUEUEqueues(CPQueue cpq)
+{
+  return cpq->queues;
+}
+
+void CPQUEUEprint(CPQueue cpq, void (*callback)(const void *data))
+{
+  int i;
+
+  for (i = 0; i < cpq->queues; i++)
+    {
+      pthread_mutex_lock(&cpq->slots[i].shard.lock);
+      printf("\nQueue #%03d:", i);
+      HEAPprint(cpq->slots[i].shard.heap, callback);
+      pthread_mutex_unlock(&cpq->slots[i].shard.lock);
+    }
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static unsigned int rnd(void) --- */
+static unsigned int rnd(void)
+{
+  unsigned int x = seed;
+
+  /* Seed the generator of this thread - from its stack address and arrival order */
+  if (x == 0)
+    {
+      x = (unsigned int)((size_t)&x >> 4) * 2654435761U;
+      x ^= __atomic_add_fetch(&seeded, 1, __ATOMIC_RELAXED) * 0x9e3779b9U;
+
+      if (x == 0)
+        x = 1;
+    }
+
+  /* Xorshift - cheap, and good enough for spreading load */
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+
+  seed = x;
+
+  return x;
+}
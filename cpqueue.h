@@ -0,0 +1,196 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: cpqueue.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 16:31:40 2026
+ * Version : 0.51
+ * ---
+ * Description: A concurrent priority queue - a "MultiQueue" of locked heaps - implemented
+ *              as a pure, generic ADT, on top of Heap and POSIX threads.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Stated the platform requirements - see below.
+ *
+ */
+/**
+ * @file cpqueue.h
+ *
+ * This module needs POSIX threads - and the @b __atomic builtins and
+ * thread-local storage of GCC (or Clang). It does not compile with
+ * other compilers - e.g. MSVC - and is left out of the Windows
+ * makefiles (vcwin32.mak, mingw32.mak and msys32.mak).
+ **/
+
+#ifndef _CPQUEUE_H_
+#define _CPQUEUE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "heap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Use a @b typedef - to hide the interior of @b CPQueue_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct CPQueue_ *CPQueue;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Initiate the concurrent priority queue
+   *
+   * The elements are spread over @a queues independent binary heaps -
+   * each guarded by its own lock (=a MultiQueue). An element is
+   * inserted into a heap chosen at random - skipping heaps locked by
+   * other threads. @b CPQUEUEextract() looks at the tops of two heaps
+   * chosen at random - and extracts the better one. So threads seldom
+   * wait for each other, and both operations scale with the number of
+   * threads - at the price of the extraction order being @a relaxed:
+   * the element extracted is one of the top-priority elements, but
+   * not necessarily @a the top-priority element. When order matters -
+   * use @b CPQUEUEextract_strict().
+   * All functions of this interface may be called concurrently from
+   * different threads - except @b CPQUEUEinit() and @b CPQUEUEdestroy().
+   *
+   * @param[in] queues - The number of heaps. Two to four times the
+   * number of threads accessing the queue is a good choice. With a
+   * single heap, the queue is strict - but all threads take turns.
+   * @param[in] compare - a reference to a user-defined compare
+   * function - see @b HEAPinit(). It must be thread-safe.
+   * @param[in] destroy - A reference to a user-defined function,
+   * reponsible for freeing @a element @a data, when the queue is
+   * destroyed. If @a destroy is set to NULL - then element data will
+   * be left untouched upon queue destruction.
+   * @return A reference - to a new, empty queue - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise. Take
+   * really good care of this return value, since it will be needed
+   * as a parameter in subsequent calls - to the majority of other
+   * queue functions in this function interface - i.e. a sort
+   * of "handle" to the queue.
+   * @see CPQUEUEdestroy()
+   **/
+  CPQueue CPQUEUEinit(int queues,
+                      int (*compare)(const void *key1, const void* key2),
+                      void (*destroy)(void *data));
+
+  /**
+   * Destroy the concurrent priority queue
+   *
+   * All heaps are destroyed - like @b HEAPdestroy() - and the locks
+   * released. No other thread may access the queue during - or
+   * after - this call.
+   *
+   * @param[in] cpq - a reference to current queue.
+   * @return Nothing.
+   * @see CPQUEUEinit()
+   **/
+  void CPQUEUEdestroy(CPQueue cpq);
+
+  /**
+   * Insert data into the concurrent priority queue
+   *
+   * Locks a single heap - one that is not locked by another thread,
+   * if such a heap is found quickly.
+   *
+   * @param[in] cpq - a reference to current queue.
+   * @param[in] data - a reference to data to be inserted into
+   * the queue.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value -1 - otherwise.
+   **/
+  int CPQUEUEinsert(CPQueue cpq, const void *data);
+
+  /**
+   * Remove a top-priority element from the concurrent priority queue - relaxed
+   *
+   * Compares the tops of two heaps, chosen at random - and extracts
+   * the one of higher priority. The element removed is among the top
+   * O(@a queues) elements of the queue - but not necessarily the
+   * top-priority element.
+   *
+   * @param[in] cpq - reference to current queue.
+   * @param[out] data - reference to a pointer. After the call,
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful. The caller is responsible for the future of
+   * this memory - deallocating it, for example.
+   *
+   * @return Value 0 --  if the call was OK - that is, element
+   * removed.\n
+   *         Value -1 -- otherwise (the queue was empty).
+   * @see CPQUEUEextract_strict()
+   **/
+  int CPQUEUEextract(CPQueue cpq, void **data);
+
+  /**
+   * Remove the top-priority element from the concurrent priority queue - strict
+   *
+   * Locks all heaps - and extracts the top-priority element of them
+   * all. This serializes all threads, for a while - so use it when
+   * the order of extraction really matters.
+   *
+   * @param[in] cpq - reference to current queue.
+   * @param[out] data - reference to a pointer. After the call,
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful.
+   *
+   * @return Value 0 --  if the call was OK - that is, element
+   * removed.\n
+   *         Value -1 -- otherwise (the queue was empty).
+   * @see CPQUEUEextract()
+   **/
+  int CPQUEUEextract_strict(CPQueue cpq, void **data);
+
+  /**
+   * Get the size of the concurrent priority queue
+   *
+   * A snapshot only - while other threads modify the queue.
+   *
+   * @param[in] cpq - a reference to the current queue.
+   *
+   * @return The size, that is, the number of elements
+   * in the queue.
+   **/
+  int CPQUEUEsize(CPQueue cpq);
+
+  /**
+   * Get the number of heaps of the concurrent priority queue
+   *
+   * @param[in] cpq - a reference to the current queue.
+   *
+   * @return The number of heaps - as given to @b CPQUEUEinit().
+   **/
+  int CPQUEUEqueues(CPQueue cpq);
+
+  /**
+   * Print all data of the concurrent priority queue - on screen
+   *
+   * The heaps are printed one after another - like @b HEAPprint().
+   * Each heap is locked while it is printed.
+   *
+   * @param[in] cpq - reference to current queue.
+   * @param[in] callback - reference to user-defined callback function,
+   * that gets @b read @b access to element data via its parameter
+   * @a data - to do whatever is relevant.
+   *
+   * @return - Nothing.
+   **/
+  void CPQUEUEprint(CPQueue cpq, void (*callback)(const void *data));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CPQUEUE_H_ */
@@ -14,6 +14,8 @@
  * Date   Revision message
  * 130413 Created this file
  * 150331 This code ready for version 0.51
+ * 261017 Added CSLISTinit_pool() - nodes may now be allocated from a NodePool.
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
  *
  */
 /**
@@ -24,6 +26,7 @@
 #include <stdlib.h>
 
 #include "cslist.h"
+#include "allocator.h"
 
 struct CSListElmt_
 {
@@ -37,21 +40,53 @@ struct CSList_
   int                (*match)(const void *key1, const void *key2);
   void               (*destroy)(void *data);
   struct CSListElmt_  *head;
+  NodePool           pool;      /* Node pool - or NULL, for the allocator */
+  int                ownpool;   /* Set - if the pool belongs to the list */
+  const Allocator    *alloc;    /* Allocator - of the list header and nodes */
 };
 
+static CSlistNode new_node(CSlist clist);
+static void free_node(CSlist clist, CSlistNode node);
+
 /* FUNCTION DEFINITIONS --------------------------------------------------- */
 
 CSlist CSLISTinit(void (*destroy)(void *data))
 {
   CSlist clist;
+  const Allocator *alloc = ALLOCATORget();
 
-  if ((clist = (CSlist)malloc(sizeof(struct CSList_)))==NULL)
+  if ((clist = (CSlist)ALLOCATOR_MALLOC(alloc, sizeof(struct CSList_)))==NULL)
     return NULL;
 
   clist->size = 0;
   clist->match = NULL;
   clist->destroy = destroy;
   clist->head = NULL;
+  clist->pool = NULL;
+  clist->ownpool = 0;
+  clist->alloc = alloc;
+
+  return clist;
+}
+
+CSlist CSLISTinit_pool(void (*destroy)(void *data), NodePool pool)
+{
+  CSlist clist;
+  NodePool own = NULL;
+
+  /* A private pool - unless a shared one is given */
+  if (pool == NULL && (pool = own = NODEPOOLinit(sizeof(struct CSListElmt_), 0)) == NULL)
+    return NULL;
+
+  if (NODEPOOLfit(pool, sizeof(struct CSListElmt_)) != 0 || (clist = CSLISTinit(destroy)) == NULL)
+    {
+      if (own != NULL)
+        NODEPOOLdestroy(own);
+      return NULL;
+    }
+
+  clist->pool = pool;
+  clist->ownpool = own != NULL;
 
   return clist;
 }
@@ -66,7 +101,11 @@ void CSLISTdestroy(CSlist clist)
           NULL) 
         clist->destroy(data);
     }
-  free(clist);
+
+  if (clist->ownpool)
+    NODEPOOLdestroy(clist->pool);
+
+  ALLOCATOR_FREE(clist->alloc, clist);
 }
 
 int CSLISTinsnext(CSlist clist, CSlistNode node, const void *data)
@@ -74,7 +113,7 @@ int CSLISTinsnext(CSlist clist, CSlistNode node, const void *data)
   CSlistNode newnode;
 
   /* Allocate storage for new node */
-  if ((newnode = (CSlistNode)malloc(sizeof(struct CSListElmt_))) == NULL)
+  if ((newnode = new_node(clist)) == NULL)
     return -1;
 
   newnode->data = (void *)data;
@@ -127,7 +166,7 @@ int CSLISTremnext(CSlist clist, CSlistNode node, void **data)
     }
 
   /* Free storage occupied by the old element */
-  free(oldnode);
+  free_node(clist, oldnode);
 
   /* Adjust list size to account for the removal */
   clist->size--;
@@ -235,7 +274,7 @@ int CSLISTfind_remove(CSlist clist, void **data)
   if (clist->size == 1)
     {
       *data = clist->head->data;
-      free(clist->head);
+      free_node(clist, clist->head);
       clist->head = NULL;
       clist->size--;
       return 0;
@@ -259,3 +298,20 @@ void CSLISTtraverse(CSlist clist, void (*callback)(const void *data))
         } while (curr != clist->head);
     }
 }
+
+static CSlistNode new_node(CSlist clist)
+{
+  /* From the pool - when the list has one */
+  if (clist->pool != NULL)
+    return (CSlistNode)NODEPOOLalloc(clist->pool);
+
+  return (CSlistNode)ALLOCATOR_MALLOC(clist->alloc, sizeof(struct CSListElmt_));
+}
+
+static void free_node(CSlist clist, CSlistNode node)
+{
+  if (clist->pool != NULL)
+    NODEPOOLfree(clist->pool, node);
+  else
+    ALLOCATOR_FREE(clist->alloc, node);
+}
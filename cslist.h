@@ -16,6 +16,7 @@
  * Date   Revision message
  * 130409 Created this file
  * 150331 This code ready for version 0.51
+ * 261017 Added CSLISTinit_pool() - for lists with nodes from a node pool.
  *
  */
 /**
@@ -31,6 +32,8 @@
 #include <malloc.h>
 #include <assert.h>
 
+#include "nodepool.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -69,6 +72,25 @@ extern "C" {
    **/
   CSlist CSLISTinit(void (*destroy)(void *data));
 
+  /**
+   * Initiate the list - with nodes allocated from a node pool
+   *
+   * Works like @b CSLISTinit() - but the nodes are taken from @a pool, and
+   * given back to it - instead of being allocated by @b malloc(),
+   * and freed, one by one. So insertion and removal are cheaper - and
+   * the nodes of the list lie close together in memory.
+   * @param[in] destroy - see @b CSLISTinit().
+   * @param[in] pool - a reference to a node pool - see
+   * @b NODEPOOLinit(). The pool may be shared with other lists - and
+   * must outlive all of them. If @a pool is NULL - the list gets a
+   * pool of its own, destroyed with the list.
+   * @return A reference - to a new, empty list - or NULL, if out of
+   * memory - or if the nodes of the list do not fit in the blocks of
+   * @a pool.
+   * @see CSLISTinit(), NODEPOOLinit()
+   **/
+  CSlist CSLISTinit_pool(void (*destroy)(void *data), NodePool pool);
+
   /**
    * Destroy the list. 
    * 
@@ -55,7 +55,16 @@ LEVAWC_OBJECTS =  \
 	levawc_cslist.o \
 	levawc_set.o \
 	levawc_ohashtbl.o \
-	levawc_graph.o
+	levawc_graph.o \
+	levawc_shashtbl.o \
+	levawc_cchashtbl.o \
+	levawc_cohashtbl.o \
+	levawc_pairheap.o \
+	levawc_radixheap.o \
+	levawc_cpqueue.o \
+	levawc_nodepool.o \
+	levawc_allocator.o \
+	levawc_ulist.o
 DEMO01_CFLAGS = $(____DEBUG) $(____DEBUG_47) $(____DEBUG_51) $(____DEBUG_50) \
 	-I./.. $(CPPFLAGS) $(CFLAGS)
 DEMO01_OBJECTS =  \
@@ -201,7 +210,7 @@ demo03: $(DEMO03_OBJECTS) liblevawc.a
 	$(CC) -o $@ $(DEMO03_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a
 
 demo04: $(DEMO04_OBJECTS) liblevawc.a
-	$(CC) -o $@ $(DEMO04_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a
+	$(CC) -o $@ $(DEMO04_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a -lpthread
 
 demo05: $(DEMO05_OBJECTS) liblevawc.a
 	$(CC) -o $@ $(DEMO05_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a
@@ -219,7 +228,7 @@ demo09: $(DEMO09_OBJECTS) liblevawc.a
 	$(CC) -o $@ $(DEMO09_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a
 
 demo10: $(DEMO10_OBJECTS) liblevawc.a
-	$(CC) -o $@ $(DEMO10_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a
+	$(CC) -o $@ $(DEMO10_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a -lpthread
 
 demo11: $(DEMO11_OBJECTS) liblevawc.a
 	$(CC) -o $@ $(DEMO11_OBJECTS)  $(____DEBUG_51) $(LDFLAGS)  liblevawc.a -lm
@@ -272,6 +281,33 @@ levawc_ohashtbl.o: ./../ohashtbl.c
 levawc_graph.o: ./../graph.c
 	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
 
+levawc_shashtbl.o: ./../shashtbl.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_cchashtbl.o: ./../cchashtbl.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_cohashtbl.o: ./../cohashtbl.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_pairheap.o: ./../pairheap.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_radixheap.o: ./../radixheap.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_cpqueue.o: ./../cpqueue.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_nodepool.o: ./../nodepool.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_allocator.o: ./../allocator.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_ulist.o: ./../ulist.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
 demo01_demo01.o: ./demo01.c
 	$(CC) -c -o $@ $(DEMO01_CFLAGS) $(CPPDEPS) $<
 
@@ -55,7 +55,13 @@ LEVAWC_OBJECTS =  \
 	levawc_cslist.o \
 	levawc_set.o \
 	levawc_ohashtbl.o \
-	levawc_graph.o
+	levawc_graph.o \
+	levawc_shashtbl.o \
+	levawc_pairheap.o \
+	levawc_radixheap.o \
+	levawc_nodepool.o \
+	levawc_allocator.o \
+	levawc_ulist.o
 DEMO01_CFLAGS = $(____DEBUG) $(____DEBUG_47) $(____DEBUG_51) $(____DEBUG_50) \
 	-I./.. $(CPPFLAGS) $(CFLAGS)
 DEMO01_OBJECTS =  \
@@ -272,6 +278,24 @@ levawc_ohashtbl.o: ./../ohashtbl.c
 levawc_graph.o: ./../graph.c
 	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
 
+levawc_shashtbl.o: ./../shashtbl.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_pairheap.o: ./../pairheap.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_radixheap.o: ./../radixheap.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_nodepool.o: ./../nodepool.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_allocator.o: ./../allocator.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
+levawc_ulist.o: ./../ulist.c
+	$(CC) -c -o $@ $(LEVAWC_CFLAGS) $(CPPDEPS) $<
+
 demo01_demo01.o: ./demo01.c
 	$(CC) -c -o $@ $(DEMO01_CFLAGS) $(CPPDEPS) $<
 
@@ -51,7 +51,13 @@ LEVAWC_OBJECTS =  \
 	levawc_cslist.obj \
 	levawc_set.obj \
 	levawc_ohashtbl.obj \
-	levawc_graph.obj
+	levawc_graph.obj \
+	levawc_shashtbl.obj \
+	levawc_pairheap.obj \
+	levawc_radixheap.obj \
+	levawc_nodepool.obj \
+	levawc_allocator.obj \
+	levawc_ulist.obj
 DEMO01_CFLAGS = /MD$(____DEBUG_78) /DWIN32 $(____DEBUG) $(____DEBUG_75) \
 	$(____DEBUG_76) $(______DEBUG) /Fddemo01.pdb $(____DEBUG_80) /I.\.. \
 	$(CPPFLAGS) $(CFLAGS)
@@ -444,6 +450,24 @@ levawc_ohashtbl.obj: .\..\ohashtbl.c
 levawc_graph.obj: .\..\graph.c
 	$(CC) /c /nologo /TC /Fo$@ $(LEVAWC_CFLAGS) .\..\graph.c
 
+levawc_shashtbl.obj: .\..\shashtbl.c
+	$(CC) /c /nologo /TC /Fo$@ $(LEVAWC_CFLAGS) .\..\shashtbl.c
+
+levawc_pairheap.obj: .\..\pairheap.c
+	$(CC) /c /nologo /TC /Fo$@ $(LEVAWC_CFLAGS) .\..\pairheap.c
+
+levawc_radixheap.obj: .\..\radixheap.c
+	$(CC) /c /nologo /TC /Fo$@ $(LEVAWC_CFLAGS) .\..\radixheap.c
+
+levawc_nodepool.obj: .\..\nodepool.c
+	$(CC) /c /nologo /TC /Fo$@ $(LEVAWC_CFLAGS) .\..\nodepool.c
+
+levawc_allocator.obj: .\..\allocator.c
+	$(CC) /c /nologo /TC /Fo$@ $(LEVAWC_CFLAGS) .\..\allocator.c
+
+levawc_ulist.obj: .\..\ulist.c
+	$(CC) /c /nologo /TC /Fo$@ $(LEVAWC_CFLAGS) .\..\ulist.c
+
 demo01_demo01.obj: .\demo01.c
 	$(CC) /c /nologo /TC /Fo$@ $(DEMO01_CFLAGS) .\demo01.c
 
@@ -19,7 +19,11 @@
  * 2013-02-19  Made some revision to the Doxygen documentation. Enhanced the description of
  *             in/out parameters - i.e. double-pointers.             
  * 2015-03-31  This code ready for ver. 0.51
+ * 2026-10-17  DLISTsort() now sorts in O(n log n) time - with HEAPsort(), on an array of the node data.
+ * 2026-10-17  Added DLISTinit_pool() - nodes may now be allocated from a NodePool.
+ * 2026-10-17  Memory is now allocated through the allocator of the library - see ALLOCATORset().
  *
+ * 2026-10-17  DLISTsort() is now a stable merge sort - relinking the nodes, with O(1) extra memory.
  */
 
 /**
@@ -28,6 +32,14 @@
  **/
 
 #include "dlist.h"
+#include "allocator.h"
+
+/**
+ * Macro for the max. size of a list - sorted by insertion sort
+ *
+ * Longer lists are merge sorted, by DLISTsort().
+ **/
+#define DLIST_SORT_THRESHOLD 8
 
 struct DListElmt_
 {
@@ -43,15 +55,24 @@ struct DList_
   void               (*destroy)(void *data);
   struct DListElmt_    *head;
   struct DListElmt_    *tail;
+  NodePool           pool;      /* Node pool - or NULL, for the allocator */
+  int                ownpool;   /* Set - if the pool belongs to the list */
+  const Allocator    *alloc;    /* Allocator - of the list header and nodes */
 };
 
+static void insert_sort(Dlist list, int (*cmp)(const void *key1, const void *key2));
+static void merge_sort(Dlist list, int (*cmp)(const void *key1, const void *key2));
+static DlistNode new_node(Dlist list);
+static void free_node(Dlist list, DlistNode node);
+
 /* FUNCTION DEFINITIONS ------------------------------------------------------ */
 
 Dlist DLISTinit(void (*destroy)(void *data))
 {
   Dlist list;
+  const Allocator *alloc = ALLOCATORget();
 
-  if ((list = (Dlist)malloc(sizeof(struct DList_))) == NULL)
+  if ((list = (Dlist)ALLOCATOR_MALLOC(alloc, sizeof(struct DList_))) == NULL)
     return NULL;
 
   list->size = 0;
@@ -59,6 +80,31 @@ Dlist DLISTinit(void (*destroy)(void *data))
   list->destroy = destroy;
   list->head = NULL;
   list->tail = NULL;
+  list->pool = NULL;
+  list->ownpool = 0;
+  list->alloc = alloc;
+
+  return list;
+}
+
+Dlist DLISTinit_pool(void (*destroy)(void *data), NodePool pool)
+{
+  Dlist list;
+  NodePool own = NULL;
+
+  /* A private pool - unless a shared one is given */
+  if (pool == NULL && (pool = own = NODEPOOLinit(sizeof(struct DListElmt_), 0)) == NULL)
+    return NULL;
+
+  if (NODEPOOLfit(pool, sizeof(struct DListElmt_)) != 0 || (list = DLISTinit(destroy)) == NULL)
+    {
+      if (own != NULL)
+        NODEPOOLdestroy(own);
+      return NULL;
+    }
+
+  list->pool = pool;
+  list->ownpool = own != NULL;
 
   return list;
 }
@@ -75,7 +121,11 @@ void DLISTdestroy(Dlist list)
           list->destroy(data);
         }
     }
-  free(list);
+
+  if (list->ownpool)
+    NODEPOOLdestroy(list->pool);
+
+  ALLOCATOR_FREE(list->alloc, list);
 }
 
 int DLISTinsnext(Dlist list, DlistNode node, const void *data)
@@ -87,7 +137,7 @@ int DLISTinsnext(Dlist list, DlistNode node, const void *data)
     return -1; /* --- Return error --- */
   
   /* --- Allocate space for a new node --- */
-  if ((newnode = (DlistNode)malloc(sizeof(struct DListElmt_))) == NULL)
+  if ((newnode = new_node(list)) == NULL)
     return -1;
 
   newnode->data = (void *)data;
@@ -127,7 +177,7 @@ int DLISTinsprev(Dlist list, DlistNode node, const void *data)
     return -1; /* --- Return error --- */
   
   /* --- Allocate space for a new node --- */
-  if ((newnode = (DlistNode)malloc(sizeof(struct DListElmt_))) == NULL)
+  if ((newnode = new_node(list)) == NULL)
     return -1;
 
   newnode->data = (void *)data;
@@ -188,7 +238,7 @@ int DLISTremove(Dlist list, DlistNode node, void **data)
     }
   
   /* --- Free memory occupied by 'node' --- */
-  free(node);
+  free_node(list, node);
   
   /* --- Decrease number of nodes in the list --- */
   list->size--;
@@ -278,34 +328,109 @@ int DLISTfind_remove(Dlist list, void **data)
 
 void DLISTsort(Dlist list, int (*cmp)(const void *key1, const void *key2))
 {
-  DlistNode curr, maxmin, tmp;
-  void *tmpdata;
+  if (list->size < 2)
+    return;
+
+  /* Few nodes - an insertion sort. Otherwise - a merge sort */
+  if (list->size <= DLIST_SORT_THRESHOLD)
+    insert_sort(list, cmp);
+  else
+    merge_sort(list, cmp);
+}
 
-  if (list->size > 1)
+static void insert_sort(Dlist list, int (*cmp)(const void *key1, const void *key2))
+{
+  DlistNode node, next, pos, prev;
+  DlistNode sorted = NULL;
+
+  /* Relink the nodes one by one - each one after all sorted nodes not greater (=stable) */
+  for (node = list->head; node != NULL; node = next)
     {
-      curr = list->head;
+      next = node->next;
 
-      while (curr->next)
+      if (sorted == NULL || cmp(node->data, sorted->data) < 0)
         {
-          maxmin = curr;
-          tmp = curr->next;
+          node->next = sorted;
+          sorted = node;
+          continue;
+        }
 
-          while(tmp)
-            {
-              if (cmp(tmp->data, maxmin->data) < 0)
-                maxmin = tmp;
-              tmp = tmp->next;
-            }
+      for (pos = sorted; pos->next != NULL && cmp(pos->next->data, node->data) <= 0; pos = pos->next)
+        ;
+
+      node->next = pos->next;
+      pos->next = node;
+    }
+
+  list->head = sorted;
+
+  /* Link the nodes backwards, too - and find the tail */
+  for (prev = NULL, node = list->head; node != NULL; prev = node, node = node->next)
+    node->prev = prev;
+
+  list->tail = prev;
+}
+
+static void merge_sort(Dlist list, int (*cmp)(const void *key1, const void *key2))
+{
+  DlistNode p, q, node, head, tail;
+  int size, psize, qsize, merges;
+
+  /* Bottom-up - merge runs of 1, 2, 4.. nodes, pairwise, until a single run is left */
+  head = list->head;
+
+  for (size = 1; ; size *= 2)
+    {
+      p = head;
+      head = tail = NULL;
+      merges = 0;
+
+      while (p != NULL)
+        {
+          merges++;
+
+          /* The 2nd run starts 'size' nodes after the 1st - or is empty */
+          for (q = p, psize = 0; psize < size && q != NULL; psize++)
+            q = q->next;
 
-          if (maxmin != curr)
+          qsize = size;
+
+          /* Merge the runs - taking from the 1st one, when equal (=stable) */
+          while (psize > 0 || (qsize > 0 && q != NULL))
             {
-              tmpdata = curr->data;
-              curr->data = maxmin->data;
-              maxmin->data = tmpdata;
+              if (psize > 0 && (qsize == 0 || q == NULL || cmp(p->data, q->data) <= 0))
+                {
+                  node = p;
+                  p = p->next;
+                  psize--;
+                }
+              else
+                {
+                  node = q;
+                  q = q->next;
+                  qsize--;
+                }
+
+              if (tail != NULL)
+                tail->next = node;
+              else
+                head = node;
+
+              node->prev = tail;
+              tail = node;
             }
-          curr = curr->next;
+
+          p = q;
         }
+
+      tail->next = NULL;
+
+      if (merges <= 1)
+        break;
     }
+
+  list->head = head;
+  list->tail = tail;
 }
 
 void DLISTtraverse(Dlist list, void (*callback)(const void *data), int direction)
@@ -320,3 +445,20 @@ void DLISTtraverse(Dlist list, void (*callback)(const void *data), int direction
     for (curr=list->tail; curr != NULL; curr=curr->prev)
       callback(curr->data); 
 }
+
+static DlistNode new_node(Dlist list)
+{
+  /* From the pool - when the list has one */
+  if (list->pool != NULL)
+    return (DlistNode)NODEPOOLalloc(list->pool);
+
+  return (DlistNode)ALLOCATOR_MALLOC(list->alloc, sizeof(struct DListElmt_));
+}
+
+static void free_node(Dlist list, DlistNode node)
+{
+  if (list->pool != NULL)
+    NODEPOOLfree(list->pool, node);
+  else
+    ALLOCATOR_FREE(list->alloc, node);
+}
@@ -19,6 +19,9 @@
  * 2013-02-19  Made some revision to the Doxygen documentation. Enhanced the description of
  *             in/out parameters - i.e. double-pointers.             
  * 2015-03-31  This code ready for ver. 0.51
+ * 2026-10-17  DLISTsort() now runs in O(n log n) time - see HEAPsort().
+ * 2026-10-17  Added DLISTinit_pool() - for lists with nodes from a node pool.
+ * 2026-10-17  DLISTsort() is now a stable merge sort - relinking the nodes, with O(1) extra memory.
  */
 
 /**
@@ -34,6 +37,8 @@
 #include <malloc.h>
 #include <assert.h>
 
+#include "nodepool.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -83,6 +88,25 @@ extern "C" {
    **/
   Dlist DLISTinit(void (*destroy)(void *data));
 
+  /**
+   * Initiate the list - with nodes allocated from a node pool
+   *
+   * Works like @b DLISTinit() - but the nodes are taken from @a pool, and
+   * given back to it - instead of being allocated by @b malloc(),
+   * and freed, one by one. So insertion and removal are cheaper - and
+   * the nodes of the list lie close together in memory.
+   * @param[in] destroy - see @b DLISTinit().
+   * @param[in] pool - a reference to a node pool - see
+   * @b NODEPOOLinit(). The pool may be shared with other lists - and
+   * must outlive all of them. If @a pool is NULL - the list gets a
+   * pool of its own, destroyed with the list.
+   * @return A reference - to a new, empty list - or NULL, if out of
+   * memory - or if the nodes of the list do not fit in the blocks of
+   * @a pool.
+   * @see DLISTinit(), NODEPOOLinit()
+   **/
+  Dlist DLISTinit_pool(void (*destroy)(void *data), NodePool pool);
+
   /**
    * Destroy the list. 
    * 
@@ -303,8 +327,14 @@ extern "C" {
   int DLISTfind_remove(Dlist list, void **data);
 
   /**
-   * Sort a list according to the Selection Sort Algorithm -
-   * with complexity &Theta;(n<sup>2</sup>)).
+   * Sort a list - with merge sort, in O(n log n) time
+   *
+   * The nodes are relinked - in place, by a bottom-up (=non-recursive)
+   * merge sort - with O(1) extra memory, so the sort cannot fail. Short
+   * lists - of a few nodes only - are insertion sorted instead. Each
+   * node keeps its data - so references to nodes stay valid, but not
+   * their positions. The sort is stable - i.e. nodes with equal data
+   * keep their relative order.
    * 
    * @param[in] list - reference to current list.
    * @param[in] cmp - reference to a user-defined callback function 
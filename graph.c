@@ -13,6 +13,7 @@
  * 
  * Date   Revision message
  * 150331 This code ready for version 0.51
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
  *
  */
 /**
@@ -23,6 +24,7 @@
 #include <stdlib.h>
 
 #include "graph.h"
+#include "allocator.h"
 
 struct Vertex_
 {
@@ -40,6 +42,8 @@ struct Graph_
   void (*destroy)(void *data);
   /* --- Collection of vertices within the graph --- */
   Slist vertices;
+  /* --- Allocator of the graph - and its lists --- */
+  const Allocator *alloc;
 }; 
 
 /* --- FUNCTION DEFINITIONS --- */
@@ -47,18 +51,20 @@ Graph GRAPHinit(int (*match)(const void *key1, const void *key2),
                 void (*destroy)(void *data))
 {
   Graph grtmp;
+  const Allocator *alloc = ALLOCATORget();
 
   /* Allocate memory for the graph structure */
-  if ((grtmp = (Graph)malloc(sizeof(struct Graph_))) == NULL)
+  if ((grtmp = (Graph)ALLOCATOR_MALLOC(alloc, sizeof(struct Graph_))) == NULL)
     return NULL;
 
   grtmp->match = match;
   grtmp->destroy = destroy;
   grtmp->vcount = 0;
   grtmp->ecount = 0;
+  grtmp->alloc = alloc;
 
   /* Initialize the vertex list */
-  if ((grtmp->vertices = SLISTinit(NULL)) == NULL)
+  if ((grtmp->vertices = SLISTinit_alloc(NULL, alloc)) == NULL)
     return NULL;
 
   /* Set the match-callback function into the vertex list */
@@ -85,7 +91,7 @@ void GRAPHdestroy(Graph graph)
             graph->destroy(vtx->vertexdata);
 
           /* Destroy the vertex structure */
-          free(vtx);
+          ALLOCATOR_FREE(graph->alloc, vtx);
         }
     }
 
@@ -93,7 +99,7 @@ void GRAPHdestroy(Graph graph)
   SLISTdestroy(graph->vertices);
 
   /* Destroy the graph structure */
-  free(graph);
+  ALLOCATOR_FREE(graph->alloc, graph);
 } 
 
 int GRAPHinsvertex(Graph graph, const void *data)
@@ -106,14 +112,14 @@ int GRAPHinsvertex(Graph graph, const void *data)
     return 1;
 
   /* Create the new vertex */
-  if ((vtx = (Vertex)malloc(sizeof(struct Vertex_))) == NULL)
+  if ((vtx = (Vertex)ALLOCATOR_MALLOC(graph->alloc, sizeof(struct Vertex_))) == NULL)
     return -1;
 
   /* Insert vertex data into the new vertex */
   vtx->vertexdata = (void *)data;
   
-  /* Initialize/insert the adjacent vertices(=edges) for the new vertex */
-  if ((vtx->adj_vertices = SLISTinit(graph->destroy)) == NULL)
+  /* Initialize/insert the adjacent vertices(=edges) for the new vertex - with the allocator of the graph */
+  if ((vtx->adj_vertices = SLISTinit_alloc(graph->destroy, graph->alloc)) == NULL)
     return -1;
 
   /* Set the match-callback function into the adjacent vertices(=edges) collection */
@@ -195,7 +201,7 @@ int GRAPHremvertex(Graph graph, void **data)
   SLISTdestroy(vtx->adj_vertices);
 
   /* Destroy the vertex structure */
-  free(vtx);
+  ALLOCATOR_FREE(graph->alloc, vtx);
 
   /* Adjust the vertex count to account for the removed vertex */
   graph->vcount--;
@@ -13,6 +13,19 @@
  * 
  * Date   Revision message
  * 150331 This code ready for version 0.51
+ * 261017 The heap array now grows geometrically - and shrinks with hysteresis - instead
+ *        of being reallocated on every insertion and extraction. Added HEAPreserve().
+ * 261017 Added bulk construction in linear time - HEAPbuild() and HEAPadopt().
+ * 261017 The number of children per node (=arity) is now configurable - see HEAPinit_ex().
+ *        Sifting moves a "hole" instead of swapping nodes, level by level.
+ * 261017 Added handles to elements - HEAPinsert_handle(), HEAPupdate() and HEAPremove().
+ * 261017 Added HEAPreplace(), HEAPpushpop() and HEAPextract_n() - replacing the top node
+ *        with a single sift-down - and extracting several nodes with a single shrink.
+ * 261017 Added HEAPmeld().
+ * 261017 Added a bounded top-K mode - see HEAPsettopk().
+ * 261017 Added HEAPsort() and HEAPpartial_sort() - in-place array sorting, reusing sift_down().
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ * 261017 Added HEAPreplace_handle() and HEAPpushpop_handle() - passing back the handle of the new node.
  *
  */
 
@@ -24,6 +37,7 @@
 #include <stdlib.h>
 
 #include "heap.h"
+#include "allocator.h"
 
 /**
  * Macro for level separation when calling HEAPprint()
@@ -35,33 +49,99 @@
  **/
 #define HEAP_PRINT_LEVEL_PADDING 4
 
+/**
+ * Macro for the smallest allocated capacity of the heap array
+ * 
+ * The heap array is never shrunk below this number of 
+ * elements - or the capacity reserved by HEAPreserve().
+ **/
+#define HEAP_MINCAPACITY 16
+
+/**
+ * Macro for the number of children per node - when sorting arrays
+ * 
+ * Used by HEAPsort() and HEAPpartial_sort(). A 4-ary heap needs about
+ * as many comparisons as a binary heap - but half the levels, so fewer
+ * elements are moved - and siblings share cache lines.
+ **/
+#define HEAP_SORT_ARITY 4
+
 struct Heap_ {
+  int   arity;
   int   size;
+  int   capacity;
+  int   reserved;
+  int   topk;       /* Max. size of a top-K heap - or 0 */
   int  (*compare)(const void *key1, const void *key2);
   void (*destroy)(void *data);
   void **tree;
+  const Allocator *alloc;
+
+  /* Element handles - not allocated until HEAPinsert_handle() is called */
+  int   *ids;         /* Handle of the element at each position of the tree */
+  int   *pos;         /* Position of the element of each handle - negative when free */
+  int   nhandles;     /* Allocated size of 'pos' */
+  int   usedhandles;  /* Number of handles given out so far - free or not */
+  int   freehandle;   /* First handle of the free list - or -1 */
 }; 
 
 /* STATIC FUNCTION DECLARATIONS */
 static void print_tree(Heap hp, int ele_idx, int level, void (*callback)(const void *data));
-static int HEAPparent(int npos);
-static int HEAPleft(int npos);
-static int HEAPright(int npos);
+static int resize(Heap hp, int capacity);
+static void shrink(Heap hp);
+static int insert(Heap hp, const void *data, int *handle);
+static void pop(Heap hp, void **data);
+static int replace(Heap hp, const void *data, void **top);
+static int keep_best(Heap hp, const void *data, int *handle);
+static int order(Heap hp, const void *key1, const void *key2);
+static int make_index(Heap hp);
+static int reserve_handles(Heap hp, int n);
+static void index_range(Heap hp, int from);
+static int new_handle(Heap hp);
+static void free_handle(Heap hp, int handle);
+static void heapify(Heap hp);
+static void sort_heap(Heap hp, void **arr, int n, int (*cmp)(const void *key1, const void *key2));
+static void sort_tree(Heap hp);
+static void sift_up(Heap hp, int currpos);
+static void sift_down(Heap hp, int currpos);
+static int HEAPparent(Heap hp, int npos);
+static int HEAPchild(Heap hp, int npos);
 
 
 /* --- PUBLIC FUNCTION DEFINITIONS --- */
 /* --- Function:   Heap HEAPinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data)) --- */
 Heap HEAPinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data))
+{
+  return HEAPinit_ex(compare, destroy, 2);
+}
+
+/* --- Function:   Heap HEAPinit_ex(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data), int arity) --- */
+Heap HEAPinit_ex(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data), int arity)
 {
   Heap hp;
+  const Allocator *alloc = ALLOCATORget();
 
-  if ((hp = (Heap)malloc(sizeof(struct Heap_)))==NULL)
+  if (arity < 2)
     return NULL;
 
+  if ((hp = (Heap)ALLOCATOR_MALLOC(alloc, sizeof(struct Heap_)))==NULL)
+    return NULL;
+
+  hp->arity = arity;
   hp->size = 0;
+  hp->capacity = 0;
+  hp->reserved = 0;
+  hp->topk = 0;
   hp->compare = compare;
   hp->destroy = destroy;
   hp->tree = NULL;
+  hp->alloc = alloc;
+
+  hp->ids = NULL;
+  hp->pos = NULL;
+  hp->nhandles = 0;
+  hp->usedhandles = 0;
+  hp->freehandle = -1;
  
   return hp;
 }
@@ -77,44 +157,76 @@ void HEAPdestroy(Heap hp)
         hp->destroy(hp->tree[i]);
     }
 
-  free(hp->tree);
-  free(hp);
+  ALLOCATOR_FREE(hp->alloc, hp->tree);
+  ALLOCATOR_FREE(hp->alloc, hp->ids);
+  ALLOCATOR_FREE(hp->alloc, hp->pos);
+  ALLOCATOR_FREE(hp->alloc, hp);
 }
   
 /* --- Function:   int HEAPinsert(Heap hp, const void *data) --- */
 int HEAPinsert(Heap hp, const void *data)
 {
-  void *tmp;
-  int currpos, parentpos;
+  return insert(hp, data, NULL);
+}
 
-  /* Allocate storage for the new node */
-  if ((tmp = realloc(hp->tree, (HEAPsize(hp) + 1) * sizeof(void *))) == NULL)
+/* --- Function:   int HEAPinsert_handle(Heap hp, const void *data, int *handle) --- */
+int HEAPinsert_handle(Heap hp, const void *data, int *handle)
+{
+  /* Start keeping track of handles - the first time one is asked for */
+  if (hp->ids == NULL && make_index(hp) != 0)
     return -1;
-  else
-    hp->tree = (void **)tmp;
 
-  /* Insert the node after the last node */
-  hp->tree[HEAPsize(hp)] = (void *)data;
+  return insert(hp, data, handle);
+}
 
-  /* Heapify the tree by pushing the contents of the new node upward */
-  currpos = HEAPsize(hp);
-  parentpos = HEAPparent(currpos);
+/* --- Function:   int HEAPupdate(Heap hp, int handle) --- */
+int HEAPupdate(Heap hp, int handle)
+{
+  if (hp->ids == NULL || handle < 0 || handle >= hp->usedhandles || hp->pos[handle] < 0)
+    return -1;
+
+  /* The priority may have changed either way - only one of the sifts moves the node */
+  sift_up(hp, hp->pos[handle]);
+  sift_down(hp, hp->pos[handle]);
 
-  while (currpos > 0 && hp->compare(hp->tree[parentpos], hp->tree[currpos]) < 0)
+  return 0;
+}
+
+/* --- Function:   int HEAPremove(Heap hp, int handle, void **data) --- */
+int HEAPremove(Heap hp, int handle, void **data)
+{
+  int currpos, lastpos;
+
+  if (hp->ids == NULL || handle < 0 || handle >= hp->usedhandles || hp->pos[handle] < 0)
+    return -1;
+
+  currpos = hp->pos[handle];
+  lastpos = HEAPsize(hp) - 1;
+
+  /* Pass back the data of the removed node */
+  *data = hp->tree[currpos];
+  free_handle(hp, handle);
+
+  /* Fill the gap with the last node - and put it in its right place */
+  if (currpos != lastpos)
     {
-      /* Swap the contents of the current node and its parent */
-      tmp = hp->tree[parentpos];
-      hp->tree[parentpos] = hp->tree[currpos];
-      hp->tree[currpos] = tmp;
+      hp->tree[currpos] = hp->tree[lastpos];
+      hp->ids[currpos] = hp->ids[lastpos];
+      hp->pos[hp->ids[currpos]] = currpos;
+    }
 
-      /* Move up one level in the tree to continue heapifying */
-      currpos = parentpos;
-      parentpos = HEAPparent(currpos);
+  hp->size--;
+
+  /* The moved node may belong above - or below - its new position */
+  if (currpos != lastpos)
+    {
+      handle = hp->ids[currpos];
+      sift_up(hp, currpos);
+      sift_down(hp, hp->pos[handle]);
     }
 
-  /* Adjust the size of the heap to account for the inserted node */
-  hp->size++;
-  
+  shrink(hp);
+
   return 0;
 }
 
@@ -127,88 +239,338 @@ const void *HEAPpeek(Heap hp)
 /* --- Function:   int HEAPextract(Heap hp, void **data) --- */
 int HEAPextract(Heap hp, void **data)
 {
-  void *save, *temp;
-  int currpos, leftpos, rightpos, tmppos;
-
   /* Do not allow extraction from an empty heap */
   if (HEAPsize(hp) == 0)
     return -1;
 
-  /* Extract and return node data at the top of the heap */
-  *data = hp->tree[0];
+  pop(hp, data);
+  shrink(hp);
 
-  /* Store/Backup data of the last noded of the heap */
-  save = hp->tree[HEAPsize(hp) - 1];
+  return 0;     
+}
 
-  /* Adjust(=Shrink) the size of the heap */
-  if (HEAPsize(hp) - 1 > 0)
+/* --- Function: int HEAPextract_n(Heap hp, void **data, int k) --- */
+int HEAPextract_n(Heap hp, void **data, int k)
+{
+  int i;
+
+  if (k < 0)
+    return -1;
+
+  if (k > HEAPsize(hp))
+    k = HEAPsize(hp);
+
+  /* Extract in priority order - but shrink the heap array once only, at the end */
+  for (i = 0; i < k; i++)
+    pop(hp, &data[i]);
+
+  shrink(hp);
+
+  return k;
+}
+
+/* --- Function: int HEAPreplace(Heap hp, const void *data, void **top) --- */
+int HEAPreplace(Heap hp, const void *data, void **top)
+{
+  /* There is no top node to replace - in an empty heap */
+  if (HEAPsize(hp) == 0)
+    return -1;
+
+  /* The new node needs a handle of its own - the old one goes stale */
+  if (hp->ids != NULL && reserve_handles(hp, 1) != 0)
+    return -1;
+
+  replace(hp, data, top);
+
+  return 0;
+}
+
+/* --- Function: int HEAPpushpop(Heap hp, const void *data, void **top) --- */
+int HEAPpushpop(Heap hp, const void *data, void **top)
+{
+  /* Pushing data - and popping it right away - leaves the heap untouched */
+  if (HEAPsize(hp) == 0 || order(hp, data, hp->tree[0]) >= 0)
     {
-      if ((temp = (void **)realloc(hp->tree, (HEAPsize(hp) - 1) * sizeof(void *))) == NULL)
-        return -1;
-      else
-        hp->tree = temp;
-      
-      /* Adjust the size of the heap to account for the extracted node */
-      hp->size--;
+      *top = (void *)data;
+      return 0;
     }
-  else 
+
+  if (hp->ids != NULL && reserve_handles(hp, 1) != 0)
+    return -1;
+
+  replace(hp, data, top);
+
+  return 0;
+}
+
+/* --- Function: int HEAPreplace_handle(Heap hp, const void *data, void **top, int *handle) --- */
+int HEAPreplace_handle(Heap hp, const void *data, void **top, int *handle)
+{
+  if (HEAPsize(hp) == 0)
+    return -1;
+
+  /* Start keeping track of handles - the first time one is asked for */
+  if (hp->ids == NULL && make_index(hp) != 0)
+    return -1;
+
+  if (reserve_handles(hp, 1) != 0)
+    return -1;
+
+  *handle = replace(hp, data, top);
+
+  return 0;
+}
+
+/* --- Function: int HEAPpushpop_handle(Heap hp, const void *data, void **top, int *handle) --- */
+int HEAPpushpop_handle(Heap hp, const void *data, void **top, int *handle)
+{
+  /* The new data never enters the heap - so it gets no handle */
+  if (HEAPsize(hp) == 0 || order(hp, data, hp->tree[0]) >= 0)
     {
-      /* Manage the heap when extracting the last node - and return from call */
-      free(hp->tree);
-      hp->tree = NULL;
-      hp->size = 0;
+      *top = (void *)data;
+      *handle = -1;
+      return 0;
+    }
+
+  if (hp->ids == NULL && make_index(hp) != 0)
+    return -1;
+
+  if (reserve_handles(hp, 1) != 0)
+    return -1;
+
+  *handle = replace(hp, data, top);
+
+  return 0;
+}
+
+/* --- Function: int HEAPsize(Heap hp) --- */
+int HEAPsize(Heap hp)
+{
+  return hp->size;
+}
+
+/* --- Function: int HEAPbuild(Heap hp, void **data, int n) --- */
+int HEAPbuild(Heap hp, void **data, int n)
+{
+  int i;
+
+  if (n < 0)
+    return -1;
+
+  /* A top-K heap keeps the best elements only - they are inserted one by one */
+  if (hp->topk > 0)
+    {
+      if (hp->ids != NULL && reserve_handles(hp, n) != 0)
+        return -1;
+
+      for (i = 0; i < n; i++)
+        insert(hp, data[i], NULL);
 
       return 0;
     }
 
-  /* Copy the (earlier saved), last node - to the top */
-  hp->tree[0] = save;
+  /* Make room for all elements - with one single allocation */
+  if (HEAPsize(hp) + n > hp->capacity && resize(hp, HEAPsize(hp) + n) != 0)
+    return -1;
+
+  if (hp->ids != NULL && reserve_handles(hp, n) != 0)
+    return -1;
+
+  for (i = 0; i < n; i++)
+    hp->tree[hp->size + i] = data[i];
+
+  hp->size += n;
+
+  /* The new elements get handles, too - if handles are in use */
+  if (hp->ids != NULL)
+    index_range(hp, hp->size - n);
 
-  /* Heapify the tree by pushing the contents of the new top - downwards... */
-  currpos = 0;
+  heapify(hp);
 
-  /* leftpos = HEAPleft(currpos); */
-  /* rightpos = HEAPright(currpos); */
+  return 0;
+}
+
+/* --- Function: int HEAPadopt(Heap hp, void **data, int n) --- */
+int HEAPadopt(Heap hp, void **data, int n)
+{
+  int *ids;
+
+  /* Only an empty heap - of unbounded size - can take over an array */
+  if (HEAPsize(hp) != 0 || n < 0 || hp->topk > 0)
+    return -1;
 
-  while (1) 
+  /* The handles of the positions must fit the new array */
+  if (hp->ids != NULL)
     {
-      /* Select the child to swap with the current node */
-      leftpos = HEAPleft(currpos);
-      rightpos = HEAPright(currpos);
+      if (reserve_handles(hp, n) != 0 || (ids = (int *)ALLOCATOR_REALLOC(hp->alloc, hp->ids, (n > 0 ? n : 1) * sizeof(int))) == NULL)
+        return -1;
 
-      if (leftpos < HEAPsize(hp) && hp->compare(hp->tree[leftpos], hp->tree[currpos]) > 0) 
-        tmppos = leftpos;
-      else
-        tmppos = currpos;
+      hp->ids = ids;
+    }
 
-      if (rightpos < HEAPsize(hp) && hp->compare(hp->tree[rightpos], hp->tree[tmppos]) > 0) 
-        tmppos = rightpos;
+  ALLOCATOR_FREE(hp->alloc, hp->tree);
+  hp->tree = data;
+  hp->size = n;
+  hp->capacity = n;
 
-      /* When tmppos is equal to currpos, the heap property has been restored */
-      if (tmppos == currpos) 
-        {
-          /* Time to return to caller... */
-          break;
-        }
-      else 
-        {
-          /* Swap the contents of the current node and the selected child */
-          temp = hp->tree[tmppos];
-          hp->tree[tmppos] = hp->tree[currpos];
-          hp->tree[currpos] = temp;
+  if (hp->ids != NULL)
+    index_range(hp, 0);
 
-          /* Move down one level in the tree to continue heapifying */
-          currpos = tmppos;
-        }
+  heapify(hp);
+
+  return 0;
+}
+
+/* --- Function: int HEAPmeld(Heap hp1, Heap hp2) --- */
+int HEAPmeld(Heap hp1, Heap hp2)
+{
+  int i, depth;
+
+  if (hp1 == hp2)
+    return -1;
+
+  /* A few elements are cheaper to insert one by one - than to rebuild the whole heap */
+  for (depth = 0, i = HEAPsize(hp1); i > 0; i /= hp1->arity)
+    depth++;
+
+  if (hp1->topk > 0)
+    {
+      /* The elements of 'hp2' compete for a place - one by one */
+      if (hp1->ids != NULL && reserve_handles(hp1, HEAPsize(hp2)) != 0)
+        return -1;
+
+      for (i = 0; i < HEAPsize(hp2); i++)
+        insert(hp1, hp2->tree[i], NULL);
     }
+  else if ((long)HEAPsize(hp2) * depth < HEAPsize(hp1))
+    {
+      /* Make room first - so no insertion can fail halfway */
+      if (HEAPsize(hp1) + HEAPsize(hp2) > hp1->capacity && resize(hp1, HEAPsize(hp1) + HEAPsize(hp2)) != 0)
+        return -1;
 
-  return 0;     
+      if (hp1->ids != NULL && reserve_handles(hp1, HEAPsize(hp2)) != 0)
+        return -1;
+
+      for (i = 0; i < HEAPsize(hp2); i++)
+        insert(hp1, hp2->tree[i], NULL);
+    }
+  else if (HEAPbuild(hp1, hp2->tree, HEAPsize(hp2)) != 0)
+    return -1;
+
+  /* All elements now belong to 'hp1' - the handles of 'hp2' are stale */
+  hp2->size = 0;
+
+  if (hp2->ids != NULL)
+    {
+      ALLOCATOR_FREE(hp2->alloc, hp2->ids);
+      ALLOCATOR_FREE(hp2->alloc, hp2->pos);
+      hp2->ids = NULL;
+      hp2->pos = NULL;
+      hp2->nhandles = 0;
+      hp2->usedhandles = 0;
+      hp2->freehandle = -1;
+    }
+
+  shrink(hp2);
+
+  return 0;
 }
 
-/* --- Function: int HEAPsize(Heap hp) --- */
-int HEAPsize(Heap hp)
+/* --- Function: int HEAPsettopk(Heap hp, int k) --- */
+int HEAPsettopk(Heap hp, int k)
 {
-  return hp->size;
+  int topk = hp->topk;
+
+  if (k < 0 || (k > 0 && HEAPsize(hp) > k))
+    return -1;
+
+  /* All memory of a top-K heap - at once */
+  if (k > 0)
+    {
+      if (k > hp->capacity && resize(hp, k) != 0)
+        return -1;
+
+      hp->reserved = k;
+    }
+
+  hp->topk = k;
+
+  /* The order of the heap is reversed - when the mode is switched */
+  if ((topk > 0) != (k > 0))
+    heapify(hp);
+
+  return 0;
+}
+
+/* --- Function: int HEAPtopk(Heap hp) --- */
+int HEAPtopk(Heap hp)
+{
+  return hp->topk;
+}
+
+/* --- Function: int HEAPreserve(Heap hp, int capacity) --- */
+int HEAPreserve(Heap hp, int capacity)
+{
+  /* Never shrink below this capacity - from now on */
+  hp->reserved = capacity;
+
+  if (capacity <= hp->capacity)
+    return 0;
+
+  return resize(hp, capacity);
+}
+
+/* --- Function: int HEAPsort(void **arr, int n, int (*cmp)(const void *key1, const void *key2)) --- */
+int HEAPsort(void **arr, int n, int (*cmp)(const void *key1, const void *key2))
+{
+  struct Heap_ heap;
+
+  if (n < 0)
+    return -1;
+
+  /* A max-heap - on top of the caller's array. No memory is allocated */
+  sort_heap(&heap, arr, n, cmp);
+  heapify(&heap);
+  sort_tree(&heap);
+
+  return 0;
+}
+
+/* --- Function: int HEAPpartial_sort(void **arr, int n, int k, int (*cmp)(const void *key1, const void *key2)) --- */
+int HEAPpartial_sort(void **arr, int n, int k, int (*cmp)(const void *key1, const void *key2))
+{
+  struct Heap_ heap;
+  void *tmp;
+  int i;
+
+  if (n < 0 || k < 0)
+    return -1;
+
+  if (k > n)
+    k = n;
+
+  if (k == 0)
+    return 0;
+
+  /* A max-heap of the first k elements - the largest of them on top */
+  sort_heap(&heap, arr, k, cmp);
+  heapify(&heap);
+
+  /* Swap every smaller element of the rest - for the top */
+  for (i = k; i < n; i++)
+    {
+      if (cmp(arr[i], arr[0]) < 0)
+        {
+          tmp = arr[0];
+          arr[0] = arr[i];
+          arr[i] = tmp;
+          sift_down(&heap, 0);
+        }
+    }
+
+  sort_tree(&heap);
+
+  return 0;
 }
 
 /* --- Function: void HEAPprint(Heap hp, void (*callback)(const void *data)) --- */
@@ -235,40 +597,435 @@ void HEAPprint(Heap hp, void (*callback)(const void *data))
 static void print_tree(Heap hp, int ele_idx, int level, void (*callback)(const void *data))
 {
   char *p_msk;
+  int i;
 
   /* Recursion condition */
   if (ele_idx >= hp->size)
     return;
 
   /* Print current element data */
-  p_msk = (char *)malloc((HEAP_PRINT_LEVEL_PADDING*level+1)*sizeof(char));
+  p_msk = (char *)ALLOCATOR_MALLOC(hp->alloc, (HEAP_PRINT_LEVEL_PADDING*level+1)*sizeof(char));
   assert(p_msk);
   memset(p_msk, '-', HEAP_PRINT_LEVEL_PADDING*level);
   p_msk[HEAP_PRINT_LEVEL_PADDING*level] = '\0';
   printf("%s", p_msk);
   callback(hp->tree[ele_idx]);
   printf("\n");
-  free(p_msk);
+  ALLOCATOR_FREE(hp->alloc, p_msk);
 
   /* Recursively print "subtrees" of the heap... */
-  print_tree(hp, HEAPleft(ele_idx), level+1, callback);
-  print_tree(hp, HEAPright(ele_idx), level+1, callback);
+  for (i = 0; i < hp->arity; i++)
+    print_tree(hp, HEAPchild(hp, ele_idx) + i, level+1, callback);
+}
+
+/* --- Function: static void sift_up(Heap hp, int currpos) --- */
+static void sift_up(Heap hp, int currpos)
+{
+  void *data;
+  int parentpos, id;
+
+  /* Move parents down into the "hole" - until the right level is found for the data */
+  data = hp->tree[currpos];
+  id = hp->ids != NULL ? hp->ids[currpos] : 0;
+
+  while (currpos > 0)
+    {
+      parentpos = HEAPparent(hp, currpos);
+
+      if (order(hp, hp->tree[parentpos], data) >= 0)
+        break;
+
+      hp->tree[currpos] = hp->tree[parentpos];
+
+      if (hp->ids != NULL)
+        {
+          hp->ids[currpos] = hp->ids[parentpos];
+          hp->pos[hp->ids[currpos]] = currpos;
+        }
+
+      /* Move up one level in the tree to continue heapifying */
+      currpos = parentpos;
+    }
+
+  hp->tree[currpos] = data;
+
+  if (hp->ids != NULL)
+    {
+      hp->ids[currpos] = id;
+      hp->pos[id] = currpos;
+    }
+}
+
+/* --- Function: static void sift_down(Heap hp, int currpos) --- */
+static void sift_down(Heap hp, int currpos)
+{
+  void *data;
+  int childpos, lastpos, tmppos, i, id;
+
+  /* Move children up into the "hole" - until the right level is found for the data */
+  data = hp->tree[currpos];
+  id = hp->ids != NULL ? hp->ids[currpos] : 0;
+
+  while ((childpos = HEAPchild(hp, currpos)) < HEAPsize(hp))
+    {
+      /* Select the top-priority child - all siblings are adjacent in the heap array */
+      lastpos = childpos + hp->arity < HEAPsize(hp) ? childpos + hp->arity : HEAPsize(hp);
+      tmppos = childpos;
+
+      for (i = childpos + 1; i < lastpos; i++)
+        {
+          if (order(hp, hp->tree[i], hp->tree[tmppos]) > 0)
+            tmppos = i;
+        }
+
+      /* When no child has a higher priority, the heap property has been restored */
+      if (order(hp, hp->tree[tmppos], data) <= 0)
+        break;
+
+      hp->tree[currpos] = hp->tree[tmppos];
+
+      if (hp->ids != NULL)
+        {
+          hp->ids[currpos] = hp->ids[tmppos];
+          hp->pos[hp->ids[currpos]] = currpos;
+        }
+
+      /* Move down one level in the tree to continue heapifying */
+      currpos = tmppos;
+    }
+
+  hp->tree[currpos] = data;
+
+  if (hp->ids != NULL)
+    {
+      hp->ids[currpos] = id;
+      hp->pos[id] = currpos;
+    }
+}
+
+/* --- Function: static int resize(Heap hp, int capacity) --- */
+static int resize(Heap hp, int capacity)
+{
+  void **tmp;
+  int *ids;
+
+  /* The handles of the positions - are kept in an array of the same capacity. When
+     growing - an array bigger than needed is harmless, if the 2nd allocation fails */
+  if (hp->ids != NULL && capacity > hp->capacity)
+    {
+      if ((ids = (int *)ALLOCATOR_REALLOC(hp->alloc, hp->ids, capacity * sizeof(int))) == NULL)
+        return -1;
+
+      hp->ids = ids;
+    }
+
+  if ((tmp = (void **)ALLOCATOR_REALLOC(hp->alloc, hp->tree, capacity * sizeof(void *))) == NULL)
+    return -1;
+
+  hp->tree = tmp;
+
+  if (hp->ids != NULL && capacity < hp->capacity && (ids = (int *)ALLOCATOR_REALLOC(hp->alloc, hp->ids, capacity * sizeof(int))) != NULL)
+    hp->ids = ids;
+
+  hp->capacity = capacity;
+
+  return 0;
+}
+
+/* --- Function: static void shrink(Heap hp) --- */
+static void shrink(Heap hp)
+{
+  int capacity;
+
+  /* Shrink the heap array - when no more than a quarter of it is used. Halving
+     it leaves room for growth again, so no size oscillates between two capacities.
+     A failing shrink is harmless - the larger array is kept */
+  if (HEAPsize(hp) <= hp->capacity / 4)
+    {
+      capacity = hp->capacity / 2;
+
+      /* Several nodes may have been extracted at once - see HEAPextract_n() */
+      while (HEAPsize(hp) <= capacity / 4 && capacity / 2 >= HEAP_MINCAPACITY)
+        capacity /= 2;
+
+      if (capacity < hp->reserved)
+        capacity = hp->reserved;
+
+      if (capacity < HEAP_MINCAPACITY)
+        capacity = HEAP_MINCAPACITY;
+
+      if (capacity < hp->capacity)
+        resize(hp, capacity);
+    }
+}
+
+/* --- Function: static int insert(Heap hp, const void *data, int *handle) --- */
+static int insert(Heap hp, const void *data, int *handle)
+{
+  /* A full top-K heap - has no room for another node */
+  if (hp->topk > 0 && HEAPsize(hp) == hp->topk)
+    return keep_best(hp, data, handle);
+
+  /* Make room for the new node - doubling the capacity, when full */
+  if (HEAPsize(hp) == hp->capacity)
+    {
+      if (resize(hp, hp->capacity < HEAP_MINCAPACITY ? HEAP_MINCAPACITY : 2 * hp->capacity) != 0)
+        return -1;
+    }
+
+  /* Every node gets a handle - once handles are in use */
+  if (hp->ids != NULL && reserve_handles(hp, 1) != 0)
+    return -1;
+
+  /* Insert the node after the last node - and adjust the size of the heap */
+  hp->tree[HEAPsize(hp)] = (void *)data;
+  hp->size++;
+
+  if (hp->ids != NULL)
+    {
+      index_range(hp, HEAPsize(hp) - 1);
+
+      if (handle != NULL)
+        *handle = hp->ids[HEAPsize(hp) - 1];
+    }
+
+  /* Heapify the tree by pushing the contents of the new node upward */
+  sift_up(hp, HEAPsize(hp) - 1);
+
+  return 0;
+}
+
+/* --- Function: static void pop(Heap hp, void **data) --- */
+static void pop(Heap hp, void **data)
+{
+  int lastpos = HEAPsize(hp) - 1;
+
+  /* Extract and return node data at the top of the heap */
+  *data = hp->tree[0];
+
+  if (hp->ids != NULL)
+    free_handle(hp, hp->ids[0]);
+
+  /* Adjust the size of the heap to account for the extracted node */
+  hp->size--;
+
+  /* Nothing left to heapify - when the last node was extracted */
+  if (lastpos == 0)
+    return;
+
+  /* Move the last node to the top... */
+  hp->tree[0] = hp->tree[lastpos];
+
+  if (hp->ids != NULL)
+    hp->ids[0] = hp->ids[lastpos];
+
+  /* ...and heapify the tree by pushing the contents of the new top - downwards */
+  sift_down(hp, 0);
+}
+
+/* --- Function: static int replace(Heap hp, const void *data, void **top) --- */
+static int replace(Heap hp, const void *data, void **top)
+{
+  int handle = -1;
+
+  /* Swap the data of the top node - room for a new handle has been reserved already */
+  *top = hp->tree[0];
+  hp->tree[0] = (void *)data;
+
+  /* Take the new handle before freeing the old one - so it is not reused at once */
+  if (hp->ids != NULL)
+    {
+      handle = new_handle(hp);
+      free_handle(hp, hp->ids[0]);
+      hp->ids[0] = handle;
+    }
+
+  /* A single pass downwards - instead of one down (extract) and one up (insert) */
+  sift_down(hp, 0);
+
+  return handle;
+}
+
+/* --- Function: static int keep_best(Heap hp, const void *data, int *handle) --- */
+static int keep_best(Heap hp, const void *data, int *handle)
+{
+  void *worst;
+  int newhandle;
+
+  /* The top of a top-K heap is the worst element kept - a single comparison
+     tells if the new data is any better */
+  if (hp->compare(data, hp->tree[0]) <= 0)
+    {
+      if (handle != NULL)
+        *handle = -1;
+
+      if (hp->destroy != NULL)
+        hp->destroy((void *)data);
+
+      return 1;
+    }
+
+  if (hp->ids != NULL && reserve_handles(hp, 1) != 0)
+    return -1;
+
+  /* Evict the worst element - in favour of the new one */
+  newhandle = replace(hp, data, &worst);
+
+  if (handle != NULL)
+    *handle = newhandle;
+
+  if (hp->destroy != NULL)
+    hp->destroy(worst);
+
+  return 0;
+}
+
+/* --- Function: static int order(Heap hp, const void *key1, const void *key2) --- */
+static int order(Heap hp, const void *key1, const void *key2)
+{
+  /* A top-K heap keeps its lowest-priority element at the top */
+  return hp->topk > 0 ? hp->compare(key2, key1) : hp->compare(key1, key2);
+}
+
+/* --- Function: static int make_index(Heap hp) --- */
+static int make_index(Heap hp)
+{
+  if ((hp->ids = (int *)ALLOCATOR_MALLOC(hp->alloc, (hp->capacity > 0 ? hp->capacity : 1) * sizeof(int))) == NULL)
+    return -1;
+
+  if (reserve_handles(hp, HEAPsize(hp)) != 0)
+    {
+      ALLOCATOR_FREE(hp->alloc, hp->ids);
+      hp->ids = NULL;
+      return -1;
+    }
+
+  /* Elements already in the heap - get handles, too */
+  index_range(hp, 0);
+
+  return 0;
+}
+
+/* --- Function: static int reserve_handles(Heap hp, int n) --- */
+static int reserve_handles(Heap hp, int n)
+{
+  int *pos, nhandles;
+
+  /* Room for 'n' new handles - without counting on the free list */
+  if (hp->usedhandles + n <= hp->nhandles)
+    return 0;
+
+  nhandles = hp->nhandles < HEAP_MINCAPACITY ? HEAP_MINCAPACITY : 2 * hp->nhandles;
+
+  if (nhandles < hp->usedhandles + n)
+    nhandles = hp->usedhandles + n;
+
+  if ((pos = (int *)ALLOCATOR_REALLOC(hp->alloc, hp->pos, nhandles * sizeof(int))) == NULL)
+    return -1;
+
+  hp->pos = pos;
+  hp->nhandles = nhandles;
+
+  return 0;
+}
+
+/* --- Function: static void index_range(Heap hp, int from) --- */
+static void index_range(Heap hp, int from)
+{
+  int i, handle;
+
+  /* Give a handle to each node from position 'from' - up to the end of the heap. Room
+     for the handles has been reserved already */
+  for (i = from; i < HEAPsize(hp); i++)
+    {
+      handle = new_handle(hp);
+      hp->ids[i] = handle;
+      hp->pos[handle] = i;
+    }
+}
+
+/* --- Function: static int new_handle(Heap hp) --- */
+static int new_handle(Heap hp)
+{
+  int handle;
+
+  /* Reuse a free handle - if any */
+  if (hp->freehandle >= 0)
+    {
+      handle = hp->freehandle;
+      hp->freehandle = -hp->pos[handle] - 2;
+    }
+  else
+    handle = hp->usedhandles++;
+
+  return handle;
+}
+
+/* --- Function: static void free_handle(Heap hp, int handle) --- */
+static void free_handle(Heap hp, int handle)
+{
+  /* A free handle has a negative position - encoding the next one of the free list */
+  hp->pos[handle] = -hp->freehandle - 2;
+  hp->freehandle = handle;
+}
+
+/* --- Function: static void heapify(Heap hp) --- */
+static void heapify(Heap hp)
+{
+  int i;
+
+  /* Heapify bottom-up - every subtree from the last parent up to the root (Floyd) */
+  if (HEAPsize(hp) > 1)
+    {
+      for (i = HEAPparent(hp, HEAPsize(hp) - 1); i >= 0; i--)
+        sift_down(hp, i);
+    }
+}
+
+/* --- Function: static void sort_heap(Heap hp, void **arr, int n, int (*cmp)(const void *key1, const void *key2)) --- */
+static void sort_heap(Heap hp, void **arr, int n, int (*cmp)(const void *key1, const void *key2))
+{
+  /* A heap without handles - or memory of its own - over the array */
+  hp->arity = HEAP_SORT_ARITY;
+  hp->size = n;
+  hp->capacity = n;
+  hp->reserved = n;
+  hp->topk = 0;
+  hp->compare = cmp;
+  hp->destroy = NULL;
+  hp->tree = arr;
+  hp->alloc = ALLOCATORget();
+
+  hp->ids = NULL;
+  hp->pos = NULL;
+  hp->nhandles = 0;
+  hp->usedhandles = 0;
+  hp->freehandle = -1;
 }
 
-/* --- Function: static int HEAPparent(int npos) --- */
-static int HEAPparent(int npos)
+/* --- Function: static void sort_tree(Heap hp) --- */
+static void sort_tree(Heap hp)
 {
-  return (npos-1)/2;
+  void *top;
+
+  /* Move the top to the end of the heap - which shrinks by one - until sorted */
+  while (hp->size > 1)
+    {
+      top = hp->tree[0];
+      hp->tree[0] = hp->tree[--hp->size];
+      sift_down(hp, 0);
+      hp->tree[hp->size] = top;
+    }
 }
 
-/* --- Function: static int HEAPleft(int npos) --- */
-static int HEAPleft(int npos)
+/* --- Function: static int HEAPparent(Heap hp, int npos) --- */
+static int HEAPparent(Heap hp, int npos)
 {
-  return npos*2+1;
+  return (npos-1)/hp->arity;
 }
 
-/* --- Function: static int HEAPright(int npos) --- */
-static int HEAPright(int npos)
+/* --- Function: static int HEAPchild(Heap hp, int npos) --- */
+static int HEAPchild(Heap hp, int npos)
 {
-  return npos*2+2;
+  return npos*hp->arity+1;
 }
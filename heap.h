@@ -16,6 +16,16 @@
  * Date   Revision message
  * 130217 Created this file
  * 150331 This code ready for version 0.51
+ * 261017 Added HEAPreserve() - the heap array now grows and shrinks geometrically.
+ * 261017 Added HEAPbuild() and HEAPadopt().
+ * 261017 Added HEAPinit_ex() - for heaps with more than 2 children per node.
+ * 261017 Added HEAPinsert_handle(), HEAPupdate() and HEAPremove() - for addressable heaps.
+ * 261017 Added HEAPreplace(), HEAPpushpop() and HEAPextract_n().
+ * 261017 Added HEAPmeld().
+ * 261017 Added HEAPsettopk() and HEAPtopk() - for bounded top-K heaps.
+ * 261017 Added HEAPsort() and HEAPpartial_sort().
+ * 261017 Heaps now allocate memory through the allocator of the library - see allocator.h.
+ * 261017 Added HEAPreplace_handle() and HEAPpushpop_handle().
  *
  */
 /**
@@ -67,6 +77,28 @@ extern "C" {
    **/
   Heap HEAPinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data));
 
+  /**
+   * Initiate a d-ary heap
+   * 
+   * Works like @b HEAPinit() - which creates a binary heap - but
+   * every node of the heap tree gets @a arity children. All children
+   * of a node are adjacent in the heap array, so with 4 or 8 children
+   * - and pointer-sized elements - they share a cache line. The tree
+   * gets shallower, so extraction touches fewer cache lines - at the
+   * cost of more comparisons per level. Insertion gets cheaper, too.
+   * @param[in] compare - a reference to a user-defined compare
+   * function - see @b HEAPinit().
+   * @param[in] destroy - a reference to a user-defined function,
+   * reponsible for freeing @a element @a data - or NULL.
+   * @param[in] arity - the number of children per node - at least 2.
+   * Use 4 or 8 for large heaps.
+   * @return A reference - to a new, empty heap - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise (also
+   * returned for an @a arity less than 2).
+   * @see HEAPinit()
+   **/
+  Heap HEAPinit_ex(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data), int arity);
+
   /**
    * Destroy the heap
    * 
@@ -96,14 +128,78 @@ extern "C" {
    * ensure,  that this memory is valid as long as it is present in the 
    * heap.
    *
+   * In a full top-K heap - see @b HEAPsettopk() - the data is either
+   * rejected, or takes the place of the worst element kept.
+   *
    * @param[in] hp - a reference to current heap.
    * @param[in] data - a reference to data to be inserted into
    * the heap.
    * @return Value 0 - if insertion was succesful\n
+   *         Value 1 - if the data was rejected - by a full top-K heap\n
    *         Value -1 - otherwise.
    **/
   int HEAPinsert(Heap hp, const void *data);
 
+  /**
+   * Insert data into the heap - and get a handle to it
+   * 
+   * Works like @b HEAPinsert() - but passes back a @a handle to the
+   * new element. The handle stays valid - while the element moves
+   * around in the heap - until the element is extracted or removed.
+   * Use it to tell the heap that the priority of the element has 
+   * changed - see @b HEAPupdate() - or to remove it from the heap - 
+   * see @b HEAPremove(). Handles are small, non-negative integers -
+   * reused after the element has left the heap.
+   * The heap keeps track of handles from the first call to this 
+   * function on - from then on all elements get handles, whichever
+   * function inserted them - at the cost of an extra array lookup
+   * per node moved in the heap.
+   * @param[in] hp - a reference to current heap.
+   * @param[in] data - a reference to data to be inserted into
+   * the heap.
+   * @param[out] handle - a reference to an integer - set to the
+   * handle of the new element, upon return.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value -1 - otherwise.
+   * @see HEAPupdate(), HEAPremove()
+   **/
+  int HEAPinsert_handle(Heap hp, const void *data, int *handle);
+
+  /**
+   * Restore the heap order - after the priority of an element has changed
+   * 
+   * Change the key data of the element - in place - and then call
+   * this function, with the handle of the element. The element is 
+   * moved up or down the heap, as needed - in O(log n) time. This is
+   * e.g. the @a decrease-key operation of Dijkstra's algorithm.
+   * @param[in] hp - a reference to current heap.
+   * @param[in] handle - the handle of the changed element - as
+   * passed back by @b HEAPinsert_handle().
+   * @return Value 0 - if the call was succesful\n
+   *         Value -1 - if the handle is not in use.
+   * @see HEAPinsert_handle()
+   **/
+  int HEAPupdate(Heap hp, int handle);
+
+  /**
+   * Remove an arbitrary element from the heap
+   * 
+   * Removes the element of @a handle - wherever it is in the heap -
+   * in O(log n) time.
+   * @param[in] hp - a reference to current heap.
+   * @param[in] handle - the handle of the element to be removed - 
+   * as passed back by @b HEAPinsert_handle().
+   * @param[out] data - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful. The caller is responsible for the future of
+   * this memory - deallocating it, for example.
+   * @return Value 0 - if the call was succesful\n
+   *         Value -1 - if the handle is not in use.
+   * @see HEAPinsert_handle()
+   **/
+  int HEAPremove(Heap hp, int handle, void **data);
+
   /**
    * Inspect the top-priority element of the heap
    * 
@@ -139,6 +235,109 @@ extern "C" {
    **/
   int HEAPextract(Heap hp, void **data);
 
+  /**
+   * Remove up to @a k elements from the top of the heap - in one call
+   * 
+   * Works like calling @b HEAPextract() @a k times - but the heap
+   * array is shrunk (at most) once, at the end.
+   * @param[in] hp - reference to current heap.
+   * @param[out] data - an array of (at least) @a k pointers. After
+   * the call, it holds references to the data of the removed elements
+   * - in priority order, top-priority first.
+   * @param[in] k - the max. number of elements to remove.
+   * @return The number of elements removed - i.e. @a k, or the size
+   * of the heap, whichever is smaller - or -1 if @a k is negative.
+   **/
+  int HEAPextract_n(Heap hp, void **data, int k);
+
+  /**
+   * Replace the top of the heap - with new data
+   * 
+   * Works like @b HEAPextract() followed by @b HEAPinsert() - but
+   * the new data is put at the top, and sifted down in a single
+   * pass. The heap array is never reallocated. Handy when the
+   * top-priority element is to be put back with a new priority - 
+   * e.g. a timer with a new deadline.
+   * If handles are in use - see @b HEAPinsert_handle() - the new
+   * element gets a new handle, and the handle of the old top goes stale.
+   * Use @b HEAPreplace_handle() - to get the new handle.
+   * @param[in] hp - reference to current heap.
+   * @param[in] data - a reference to data to be inserted into
+   * the heap.
+   * @param[out] top - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the data of the (old) top element - if the call was
+   * successful. The caller is responsible for the future of
+   * this memory.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- if the heap was empty - or out of memory.
+   * @see HEAPpushpop(), HEAPreplace_handle()
+   **/
+  int HEAPreplace(Heap hp, const void *data, void **top);
+
+  /**
+   * Replace the top of the heap - with new data - and get a handle to it
+   * 
+   * Works like @b HEAPreplace() - but passes back the @a handle of the
+   * new element, like @b HEAPinsert_handle(). So a timer put back with
+   * a new deadline can still be updated - or removed - by its handle.
+   * The handle of the old top goes stale.
+   * @param[in] hp - reference to current heap.
+   * @param[in] data - a reference to data to be inserted into
+   * the heap.
+   * @param[out] top - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the data of the (old) top element - if the call was
+   * successful.
+   * @param[out] handle - a reference to an integer - set to the
+   * handle of the new element, upon return.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- if the heap was empty - or out of memory.
+   * @see HEAPreplace(), HEAPinsert_handle()
+   **/
+  int HEAPreplace_handle(Heap hp, const void *data, void **top, int *handle);
+
+  /**
+   * Insert new data into the heap - and remove the top-priority element
+   * 
+   * Works like @b HEAPinsert() followed by @b HEAPextract() - in a single
+   * sift-down pass, at most. Unlike @b HEAPreplace(), the new data is
+   * passed right back in @a top - leaving the heap untouched - if it
+   * has a higher priority than (or equal to) the top of the heap - or
+   * if the heap is empty.
+   * @param[in] hp - reference to current heap.
+   * @param[in] data - a reference to data to be inserted into
+   * the heap.
+   * @param[out] top - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the top-priority data - of the heap, and the new data.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- otherwise (out of memory).
+   * @see HEAPreplace(), HEAPpushpop_handle()
+   **/
+  int HEAPpushpop(Heap hp, const void *data, void **top);
+
+  /**
+   * Insert new data into the heap - remove the top-priority element - and get a handle to the new data
+   * 
+   * Works like @b HEAPpushpop() - but passes back the @a handle of the
+   * new element, like @b HEAPinsert_handle(). If the new data is passed
+   * right back in @a top - it never enters the heap, and @a handle is
+   * set to -1.
+   * @param[in] hp - reference to current heap.
+   * @param[in] data - a reference to data to be inserted into
+   * the heap.
+   * @param[out] top - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the top-priority data - of the heap, and the new data.
+   * @param[out] handle - a reference to an integer - set to the
+   * handle of the new element - or -1, upon return.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- otherwise (out of memory).
+   * @see HEAPpushpop(), HEAPinsert_handle()
+   **/
+  int HEAPpushpop_handle(Heap hp, const void *data, void **top, int *handle);
+
   /**
    * Get the size of the heap
    * 
@@ -148,6 +347,162 @@ extern "C" {
    * in the heap.
    **/
   int HEAPsize(Heap hp);
+
+  /**
+   * Insert an array of data into the heap - in linear time
+   * 
+   * Works like calling @b HEAPinsert() for each element of the
+   * array @a data - but the array references are copied into the heap
+   * with (at most) one memory allocation, and the heap property is
+   * restored afterwards, bottom-up (=Floyd's method). This takes
+   * O(n) time - compared to O(n log n) for @a n separate insertions.
+   * The array itself is left untouched - and stays owned by the caller.
+   * @param[in] hp - a reference to the current heap.
+   * @param[in] data - an array of references to data to be inserted.
+   * @param[in] n - the number of elements of @a data.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise.
+   * @see HEAPadopt()
+   **/
+  int HEAPbuild(Heap hp, void **data, int n);
+
+  /**
+   * Let an empty heap take over an array of data - in linear time
+   * 
+   * Like @b HEAPbuild() - but without copying. The array @a data is
+   * turned into a heap in place, and used as the heap array from now
+   * on. It must have been allocated by the allocator of the heap -
+   * see @b ALLOCATORset() - @b malloc() (or @b realloc()), by default -
+   * since the heap will reallocate and free it - and the caller must
+   * no longer use it after the call.
+   * @param[in] hp - a reference to the current heap - which must be
+   * empty.
+   * @param[in] data - a dynamically allocated array of references to
+   * data. The heap takes ownership of the array.
+   * @param[in] n - the number of elements of @a data.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - if the heap was not empty (the array is left 
+   *         untouched, and still owned by the caller).
+   * @see HEAPbuild()
+   **/
+  int HEAPadopt(Heap hp, void **data, int n);
+
+  /**
+   * Reserve room for a number of elements in the heap
+   * 
+   * The heap array grows by doubling its capacity, when full - and
+   * shrinks by halving it, when no more than a quarter is in use. So
+   * insertion and extraction allocate memory only now and then. This
+   * function makes room for @a capacity elements at once - and keeps
+   * the heap array from shrinking below that size later on - so a heap
+   * staying within the reserved size never allocates memory at all.
+   * @param[in] hp - a reference to the current heap.
+   * @param[in] capacity - the number of elements to make room for.
+   * A value of 0 lets the heap array shrink freely again.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise (out of memory).
+   **/
+  int HEAPreserve(Heap hp, int capacity);
+
+  /**
+   * Turn the heap into a bounded top-K heap - or back
+   * 
+   * A top-K heap keeps the @a k elements of highest priority - of all
+   * elements ever inserted - e.g. the 100 highest latency samples out
+   * of a stream of millions. To make this cheap, the order of the heap
+   * is reversed: the @a lowest-priority element kept is at the top.
+   * When the heap is full, new data is compared with the top only - and
+   * either rejected (a single comparison), or put in place of the top
+   * element (a single sift-down). The memory for all @a k elements is
+   * allocated by this call - and kept, until the heap is destroyed.
+   *
+   * Rejected and evicted element data is handed over to @a destroy,
+   * if set by @b HEAPinit() - otherwise it is left untouched, and the
+   * caller is responsible for it. @b HEAPinsert() returns 1, when the
+   * new data is rejected.
+   *
+   * Note that @b HEAPpeek() and @b HEAPextract() - and all other
+   * functions referring to the @a top of the heap - refer to the
+   * @a lowest-priority element of a top-K heap. So @b HEAPextract()
+   * passes back the @a k elements - worst first.
+   * @param[in] hp - a reference to current heap.
+   * @param[in] k - the max. number of elements to keep - or 0, to turn
+   * the heap back into an ordinary (unbounded) heap.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise (more than @a k elements in the heap - or
+   *         out of memory).
+   * @see HEAPtopk()
+   **/
+  int HEAPsettopk(Heap hp, int k);
+
+  /**
+   * Get the max. size of a top-K heap
+   * 
+   * @param[in] hp - a reference to current heap.
+   * @return The number of elements kept by a top-K heap - or 0 for an
+   * ordinary heap.
+   * @see HEAPsettopk()
+   **/
+  int HEAPtopk(Heap hp);
+
+  /**
+   * Move all elements of one heap into another
+   * 
+   * All elements of @a hp2 are inserted into @a hp1 - one by one, if
+   * they are few, or with a linear-time rebuild - see @b HEAPbuild().
+   * @a hp2 is left empty, but not destroyed. Handles of elements of
+   * @a hp2 - see @b HEAPinsert_handle() - go stale. If @a hp1 uses
+   * handles, the moved elements get new ones.
+   * Both heaps must have the same @a compare function.
+   * @param[in] hp1 - a reference to the heap to insert into.
+   * @param[in] hp2 - a reference to the heap to take the elements
+   * from.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise (out of memory - or @a hp1 and @a hp2
+   *         is the same heap). Both heaps are left untouched, then.
+   **/
+  int HEAPmeld(Heap hp1, Heap hp2);
+
+  /**
+   * Sort an array of data - in place, with heapsort
+   * 
+   * No heap needs to be initiated - and no memory is allocated. The
+   * array is turned into a heap, bottom-up, and the top is moved to
+   * the end of the array - over and over again. This takes
+   * O(n log n) time - also in the worst case. The sort is not stable,
+   * i.e. equal elements may change places.
+   * @param[in] arr - an array of references to data - to be sorted.
+   * @param[in] n - the number of elements of @a arr.
+   * @param[in] cmp - a reference to a user-defined function - like
+   * @a compare of @b HEAPinit(). Returning +1 if @a key1 @a > @a key2
+   * produces an ascending sort order. For a descending order - just
+   * swap the return values -1 and 1.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise (@a n is negative).
+   * @see HEAPpartial_sort()
+   **/
+  int HEAPsort(void **arr, int n, int (*cmp)(const void *key1, const void *key2));
+
+  /**
+   * Sort the first @a k elements of an array of data - in place
+   * 
+   * After the call, the @a k smallest elements of @a arr - according
+   * to @a cmp - are found in sorted order at the beginning of the
+   * array, and the rest of the elements after them - in no particular
+   * order. This takes O(n log k) time - less than sorting it all, when
+   * only the "top 10" of a large array is wanted. No memory is
+   * allocated.
+   * @param[in] arr - an array of references to data.
+   * @param[in] n - the number of elements of @a arr.
+   * @param[in] k - the number of elements to sort. If @a k is larger
+   * than @a n - all elements are sorted.
+   * @param[in] cmp - a reference to a user-defined function - see
+   * @b HEAPsort().
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise (@a n or @a k is negative).
+   * @see HEAPsort()
+   **/
+  int HEAPpartial_sort(void **arr, int n, int k, int (*cmp)(const void *key1, const void *key2));
   
   /**
    * Print heap data on screen
@@ -0,0 +1,176 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: nodepool.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 18:02:37 2026
+ * Version : 0.51
+ * ---
+ * Description: A pool of fixed-size nodes - allocated in slabs - written in ANSI C.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ *
+ */
+
+/**
+ * @file nodepool.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nodepool.h"
+#include "allocator.h"
+
+/**
+ * Macro for the default number of blocks per slab
+ **/
+#define NODEPOOL_PERSLAB 256
+
+/* The strictest alignment of the basic types - blocks are sized in multiples of it */
+typedef union NodePoolAlign_
+{
+  void   *ptr;
+  long   l;
+  double d;
+} NodePoolAlign;
+
+/* A block on the free list */
+struct NodePoolFree_
+{
+  struct NodePoolFree_ *next;
+};
+
+struct NodePool_
+{
+  size_t size;       /* Block size - in bytes, rounded up */
+  int    perslab;
+  int    used;       /* Blocks in use */
+  int    left;       /* Blocks never handed out - of the current slab */
+  char   *next;      /* The first of them */
+  struct NodePoolFree_ *freelist;
+  NodePoolAlign        *slabs;   /* The first block of each slab links to the next slab */
+  const Allocator      *alloc;
+};
+
+/* STATIC FUNCTION DECLARATIONS */
+static size_t round_size(size_t size);
+
+
+/* --- PUBLIC FUNCTION DEFINITIONS --- */
+/* --- Function: NodePool NODEPOOLinit(size_t size, int perslab) --- */
+NodePool NODEPOOLinit(size_t size, int perslab)
+{
+  NodePool pool;
+  const Allocator *alloc = ALLOCATORget();
+
+  if (perslab < 0)
+    return NULL;
+
+  if ((pool = (NodePool)ALLOCATOR_MALLOC(alloc, sizeof(struct NodePool_))) == NULL)
+    return NULL;
+
+  pool->size = size > 0 ? round_size(size) : 0;
+  pool->perslab = perslab > 0 ? perslab : NODEPOOL_PERSLAB;
+  pool->used = 0;
+  pool->left = 0;
+  pool->next = NULL;
+  pool->freelist = NULL;
+  pool->slabs = NULL;
+  pool->alloc = alloc;
+
+  return pool;
+}
+
+/* --- Function: void NODEPOOLdestroy(NodePool pool) --- */
+void NODEPOOLdestroy(NodePool pool)
+{
+  NodePoolAlign *slab;
+
+  while ((slab = pool->slabs) != NULL)
+    {
+      pool->slabs = (NodePoolAlign *)slab->ptr;
+      ALLOCATOR_FREE(pool->alloc, slab);
+    }
+
+  ALLOCATOR_FREE(pool->alloc, pool);
+}
+
+/* --- Function: int NODEPOOLfit(NodePool pool, size_t size) --- */
+int NODEPOOLfit(NodePool pool, size_t size)
+{
+  if (pool->size == 0)
+    pool->size = round_size(size);
+
+  return size <= pool->size ? 0 : -1;
+}
+
+/* --- Function: void *NODEPOOLalloc(NodePool pool) --- */
+void *NODEPOOLalloc(NodePool pool)
+{
+  NodePoolAlign *slab;
+  void *node;
+
+  /* Reuse a block given back - the most recent one, likely still in cache */
+  if (pool->freelist != NULL)
+    {
+      node = pool->freelist;
+      pool->freelist = pool->freelist->next;
+      pool->used++;
+      return node;
+    }
+
+  if (pool->size == 0)
+    return NULL;
+
+  /* Carve the blocks of a new slab lazily - never touching memory before it is used */
+  if (pool->left == 0)
+    {
+      if ((slab = (NodePoolAlign *)ALLOCATOR_MALLOC(pool->alloc, sizeof(NodePoolAlign) + pool->perslab * pool->size)) == NULL)
+        return NULL;
+
+      slab->ptr = pool->slabs;
+      pool->slabs = slab;
+      pool->next = (char *)(slab + 1);
+      pool->left = pool->perslab;
+    }
+
+  node = pool->next;
+  pool->next += pool->size;
+  pool->left--;
+  pool->used++;
+
+  return node;
+}
+
+/* --- Function: void NODEPOOLfree(NodePool pool, void *node) --- */
+void NODEPOOLfree(NodePool pool, void *node)
+{
+  struct NodePoolFree_ *block = (struct NodePoolFree_ *)node;
+
+  block->next = pool->freelist;
+  pool->freelist = block;
+  pool->used--;
+}
+
+/* --- Function: int NODEPOOLused(NodePool pool) --- */
+int NODEPOOLused(NodePool pool)
+{
+  return pool->used;
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static size_t round_size(size_t size) --- */
+static size_t round_size(size_t size)
+{
+  /* Room for the free list link - and aligned, like any block from malloc() */
+  if (size < sizeof(struct NodePoolFree_))
+    size = sizeof(struct NodePoolFree_);
+
+  return (size + sizeof(NodePoolAlign) - 1) / sizeof(NodePoolAlign) * sizeof(NodePoolAlign);
+}
@@ -0,0 +1,126 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: nodepool.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 18:02:37 2026
+ * Version : 0.51
+ * ---
+ * Description: A pool of fixed-size nodes - allocated in slabs - written in ANSI C.
+ *
+ * Revision history - coming up below:
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ *
+ */
+/**
+ * @file nodepool.h
+ **/
+
+#ifndef _NODEPOOL_H_
+#define _NODEPOOL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Use a @b typedef - to hide the interior of @b NodePool_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct NodePool_ *NodePool;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Initiate the node pool
+   *
+   * A node pool hands out memory blocks of a single, fixed size - e.g.
+   * the nodes of a linked list. The blocks are carved out of larger
+   * chunks of memory (=slabs) - so they lie close together in memory -
+   * and blocks given back are kept on a free list, for reuse. So
+   * allocating and freeing a block takes a few instructions only -
+   * instead of a call to @b malloc() or @b free(). Memory of the pool
+   * is not given back to the system - until the pool is destroyed.
+   *
+   * A pool may be shared - by several lists, for example - see
+   * @b SLISTinit_pool(). It is not thread-safe.
+   * @param[in] size - the size of each block, in bytes - or 0, to
+   * have the size set by the first list using the pool - see
+   * @b NODEPOOLfit().
+   * @param[in] perslab - the number of blocks per slab - or 0, for a
+   * default number.
+   * @return A reference - to a new pool - if dynamic memory allocation
+   * for the ADT was successful - or NULL otherwise. Take really good
+   * care of this return value, since it will be needed as a parameter
+   * in subsequent calls - to the majority of other pool functions in
+   * this function interface - i.e. a sort of "handle" to the pool.
+   * @see NODEPOOLdestroy()
+   **/
+  NodePool NODEPOOLinit(size_t size, int perslab);
+
+  /**
+   * Destroy the node pool
+   *
+   * All slabs are freed - including blocks still in use. So all
+   * lists using the pool must be destroyed first.
+   * @param[in] pool - a reference to current pool.
+   * @return Nothing.
+   * @see NODEPOOLinit()
+   **/
+  void NODEPOOLdestroy(NodePool pool);
+
+  /**
+   * Check if blocks of the node pool fit nodes of a given size
+   *
+   * If the block size of the pool has not been set yet - see
+   * @b NODEPOOLinit() - it is set to @a size.
+   * @param[in] pool - a reference to current pool.
+   * @param[in] size - the size of the nodes to be allocated, in bytes.
+   * @return Value 0 - if blocks of the pool have room for @a size
+   *         bytes\n
+   *         Value -1 - otherwise.
+   **/
+  int NODEPOOLfit(NodePool pool, size_t size);
+
+  /**
+   * Allocate a block from the node pool
+   *
+   * Takes a block from the free list - or from the current slab. A
+   * new slab is allocated, when both are used up.
+   * @param[in] pool - a reference to current pool.
+   * @return A reference to the block - or NULL if out of memory.
+   **/
+  void *NODEPOOLalloc(NodePool pool);
+
+  /**
+   * Give back a block to the node pool
+   *
+   * @param[in] pool - a reference to current pool.
+   * @param[in] node - a reference to a block - allocated from @a pool
+   * by @b NODEPOOLalloc().
+   * @return Nothing.
+   **/
+  void NODEPOOLfree(NodePool pool, void *node);
+
+  /**
+   * Get the number of blocks in use
+   *
+   * @param[in] pool - a reference to current pool.
+   * @return The number of blocks - allocated, but not given back.
+   **/
+  int NODEPOOLused(NodePool pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NODEPOOL_H_ */
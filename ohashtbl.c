@@ -13,6 +13,17 @@
  * 
  * Date   Revision message
  * 150331 This code ready for version 0.51
+ * 261017 Keys are now hashed once only, per operation. A hash tag is stored per position,
+ *        so the match callback is only called when the hash values agree.
+ * 261017 Added Robin Hood linear probing - with backward-shift deletion - as an alternative
+ *        probing strategy. See OHTBLinit_ex().
+ * 261017 Added automatic growth at a configurable max. load factor - and explicit
+ *        rehashing/compaction. See OHTBLsetloadfactor() and OHTBLrehash().
+ * 261017 Added batch functions - OHTBLinsert_batch() and OHTBLlookup_batch() - hashing a
+ *        group of keys and prefetching their home positions, before resolving them.
+ * 261017 Added iteration - OHTBLfirst(), OHTBLnext() - and a parallel OHTBLforeach().
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ * 261017 Inserting a duplicate no longer grows - or rehashes - the table.
  *
  */
 /**
@@ -21,8 +32,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 #include "ohashtbl.h"
+#include "allocator.h"
 
 struct OHtbl_ 
 {
@@ -34,29 +49,95 @@ struct OHtbl_
   int       (*match)(const void *key1, const void *key2);
   void      (*destroy)(void *data);
 
+  int       probing;
   int       size;
+  int       vacancies;
+  double    maxload;
   void      **table;
+  unsigned int *hashes;
+  const Allocator *alloc;
+};
+
+/* Number of keys hashed and prefetched together - by the batch functions */
+#define OHTBL_BATCH 16
+
+/* Software prefetch of a position - where supported by the compiler */
+#if defined(__GNUC__)
+#define OHTBL_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define OHTBL_PREFETCH(addr) ((void)0)
+#endif
+
+/* Max. number of threads used by OHTBLforeach() */
+#define OHTBL_MAXTHREADS 64
+
+/* A range of positions - scanned by one thread of OHTBLforeach() */
+struct OHtblRange_
+{
+  OHtbl htbl;
+  int   from;
+  int   to;
+  void  (*callback)(void *data, void *arg);
+  void  *arg;
 };
 
 /* Reserve a sentinel memory address for vacated elements */
 static char vacated;
 
+/* STATIC FUNCTION DECLARATIONS */
+static int insert_hashed(OHtbl htbl, const void *data, unsigned int hash1, unsigned int hash2);
+static int lookup_hashed(OHtbl htbl, const void *key, unsigned int hash1, unsigned int hash2);
+static void hash_group(OHtbl htbl, const void **keys, int cnt, unsigned int *hash1, unsigned int *hash2);
+static int probe(OHtbl htbl, const void *key, unsigned int hash1, unsigned int hash2, int *freepos);
+static int rh_distance(OHtbl htbl, int position);
+static int rh_probe(OHtbl htbl, const void *key, unsigned int hash);
+static void rh_insert(OHtbl htbl, void *data, unsigned int hash);
+static void rh_remove(OHtbl htbl, int position);
+static int rebuild(OHtbl htbl, int positions);
+static int grow(OHtbl htbl);
+static int next_prime(int n);
+static void *foreach_range(void *range);
+
 /* FUNCTION DEFINITIONS */
 
 OHtbl OHTBLinit(int positions, int (*h1)(const void *key), int (*h2)(const void *key),
                 int (*match)(const void *key1, const void *key2), void (*destroy)(void *data))
+{
+  return OHTBLinit_ex(positions, h1, h2, match, destroy, OHTBL_DOUBLE);
+}
+
+OHtbl OHTBLinit_ex(int positions, int (*h1)(const void *key), int (*h2)(const void *key),
+                   int (*match)(const void *key1, const void *key2), void (*destroy)(void *data),
+                   int probing)
 {
   OHtbl htbl;
+  const Allocator *alloc = ALLOCATORget();
   int i;
 
-  /* Allocate space for the open-addressed hash table header */
-  if ((htbl = malloc(sizeof(struct OHtbl_))) == NULL)
+  /* Double hashing needs a 2nd hash function */
+  if (!(probing == OHTBL_ROBINHOOD || (probing == OHTBL_DOUBLE && h2 != NULL)))
     return NULL;
 
-  /* Allocate space for the hash table */
-  if ((htbl->table = (void **)malloc(positions * sizeof(void *))) == NULL)
+  /* Allocate space for the open-addressed hash table header */
+  if ((htbl = ALLOCATOR_MALLOC(alloc, sizeof(struct OHtbl_))) == NULL)
     return NULL;
 
+  htbl->alloc = alloc;
+
+  /* Allocate space for the hash table - and the hash tags */
+  if ((htbl->table = (void **)ALLOCATOR_MALLOC(htbl->alloc, positions * sizeof(void *))) == NULL)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl);
+      return NULL;
+    }
+
+  if ((htbl->hashes = (unsigned int *)ALLOCATOR_MALLOC(htbl->alloc, positions * sizeof(unsigned int))) == NULL)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl->table);
+      ALLOCATOR_FREE(htbl->alloc, htbl);
+      return NULL;
+    }
+
   /* Initialize each position */
   htbl->positions = positions;
 
@@ -71,9 +152,14 @@ OHtbl OHTBLinit(int positions, int (*h1)(const void *key), int (*h2)(const void
   htbl->h2 = h2;
   htbl->match = match;
   htbl->destroy = destroy;
+  htbl->probing = probing;
 
   /* Initialize the number of elements in the table */
   htbl->size = 0;
+  htbl->vacancies = 0;
+
+  /* Fixed size - until a max. load factor is set */
+  htbl->maxload = 0.0;
 
   return htbl;
 }
@@ -93,120 +179,601 @@ void OHTBLdestroy(OHtbl htbl)
     }
 
   /* Free the storage allocated for the hash table */
-  free(htbl->table);
+  ALLOCATOR_FREE(htbl->alloc, htbl->table);
+  ALLOCATOR_FREE(htbl->alloc, htbl->hashes);
 
   /* Free the storage allocated for the table header */
-  free(htbl);
+  ALLOCATOR_FREE(htbl->alloc, htbl);
 }
 
 int OHTBLinsert(OHtbl htbl, const void *data)
 {
-  void *temp;
-  int position, i;
- 
-  /* Do not exceed the number of positions in the table */
-  if (htbl->size == htbl->positions)
+  /* Hash the key - once */
+  return insert_hashed(htbl, data, (unsigned int)htbl->h1(data),
+                       htbl->probing == OHTBL_DOUBLE ? (unsigned int)htbl->h2(data) : 0);
+}
+
+int OHTBLinsert_batch(OHtbl htbl, const void **data, int n, int *results)
+{
+  unsigned int hash1[OHTBL_BATCH], hash2[OHTBL_BATCH];
+  int i, j, cnt, retval, inserted = 0;
+
+  for (i = 0; i < n; i += OHTBL_BATCH)
+    {
+      cnt = n - i < OHTBL_BATCH ? n - i : OHTBL_BATCH;
+
+      /* Hash all keys of the group - and prefetch their home positions.. */
+      hash_group(htbl, &data[i], cnt, hash1, hash2);
+
+      /* ..then resolve them, while the positions are on their way to the cache */
+      for (j = 0; j < cnt; j++)
+        {
+          retval = insert_hashed(htbl, data[i + j], hash1[j], hash2[j]);
+
+          if (results != NULL)
+            results[i + j] = retval;
+
+          if (retval == 0)
+            inserted++;
+        }
+    }
+
+  return inserted;
+}
+
+int OHTBLremove(OHtbl htbl, void **data)
+{
+  int position;
+
+  /* Hash the key - once */
+  position = lookup_hashed(htbl, *data, (unsigned int)htbl->h1(*data),
+                           htbl->probing == OHTBL_DOUBLE ? (unsigned int)htbl->h2(*data) : 0);
+
+  if (position < 0)
+    {
+      /* Return that the data was not found */
+      return -1;
+    }
+
+  /* Pass back the data from the table */
+  *data = htbl->table[position];
+
+  if (htbl->probing == OHTBL_ROBINHOOD)
+    rh_remove(htbl, position);
+  else
+    {
+      htbl->table[position] = htbl->vacated;
+      htbl->vacancies++;
+    }
+
+  htbl->size--;
+
+  return 0;
+}
+
+int OHTBLlookup(const OHtbl htbl, void **data)
+{
+  int position;
+
+  /* Hash the key - once */
+  position = lookup_hashed(htbl, *data, (unsigned int)htbl->h1(*data),
+                           htbl->probing == OHTBL_DOUBLE ? (unsigned int)htbl->h2(*data) : 0);
+
+  if (position < 0)
+    {
+      /* Return that the data was not found */
+      return -1;
+    }
+
+  /* Pass back the data from the table */
+  *data = htbl->table[position];
+  return 0;
+}
+
+int OHTBLlookup_batch(const OHtbl htbl, void **data, int n, int *results)
+{
+  unsigned int hash1[OHTBL_BATCH], hash2[OHTBL_BATCH];
+  int i, j, cnt, position, found = 0;
+
+  for (i = 0; i < n; i += OHTBL_BATCH)
+    {
+      cnt = n - i < OHTBL_BATCH ? n - i : OHTBL_BATCH;
+
+      /* Hash all keys of the group - and prefetch their home positions.. */
+      hash_group(htbl, (const void **)&data[i], cnt, hash1, hash2);
+
+      /* ..then resolve them, while the positions are on their way to the cache */
+      for (j = 0; j < cnt; j++)
+        {
+          if ((position = lookup_hashed(htbl, data[i + j], hash1[j], hash2[j])) >= 0)
+            {
+              /* Pass back the data from the table */
+              data[i + j] = htbl->table[position];
+              found++;
+            }
+
+          if (results != NULL)
+            results[i + j] = position >= 0 ? 0 : -1;
+        }
+    }
+
+  return found;
+}
+
+int OHTBLsize(OHtbl htbl)
+{
+  return htbl->size;
+}
+
+int OHTBLpositions(OHtbl htbl)
+{
+  return htbl->positions;
+}
+
+int OHTBLsetloadfactor(OHtbl htbl, double maxload)
+{
+  if (maxload > 1.0)
     return -1;
 
-  /* Do nothing if the data is already in the table */
-  temp = (void *)data;
+  /* A value <= 0 means fixed size */
+  htbl->maxload = maxload > 0.0 ? maxload : 0.0;
 
-  if (OHTBLlookup(htbl, &temp) == 0) /* Duplicate found! */
-    return 1;
+  return 0;
+}
 
-  /* Use double hashing to hash the key */
-  for (i = 0; i < htbl->positions; i++)
+int OHTBLrehash(OHtbl htbl, int positions)
+{
+  /* Default - rehash at the current size */
+  if (positions <= 0)
+    positions = htbl->positions;
+
+  if (positions < htbl->size)
+    return -1;
+
+  return rebuild(htbl, positions);
+}
+
+void OHTBLprint(OHtbl htbl, void (*callback)(const void *data))
+{
+  int i;
+
+  for (i=0; i<htbl->positions; i++)
     {
-      position = (htbl->h1(data) + (i * htbl->h2(data))) % htbl->positions;
+      if (htbl->table[i] == NULL)
+        printf("\nNULL");
+      else if (htbl->table[i] == htbl->vacated)
+        printf("\nVACATED");
+      else
+        callback(htbl->table[i]);
+    }
+}
+
+int OHTBLfirst(OHtbl htbl, OHtblIter *iter, void **data)
+{
+  iter->position = -1;
+  iter->left = htbl->size;
 
-      if (htbl->table[position] == NULL || htbl->table[position] == htbl->vacated)
+  return OHTBLnext(htbl, iter, data);
+}
+
+int OHTBLnext(OHtbl htbl, OHtblIter *iter, void **data)
+{
+  /* All elements visited - do not scan the remaining positions */
+  if (iter->left == 0)
+    return -1;
+
+  while (++iter->position < htbl->positions)
+    {
+      if (htbl->table[iter->position] != NULL && htbl->table[iter->position] != htbl->vacated)
         {
-          /* Insert the data into the table */
-          htbl->table[position] = (void *)data;
-          htbl->size++;
+          *data = htbl->table[iter->position];
+          iter->left--;
           return 0;
         }
     }
 
-  /* Return that the hash functions were selected incorrectly */
   return -1;
 }
 
-int OHTBLremove(OHtbl htbl, void **data)
+void OHTBLforeach(OHtbl htbl, void (*callback)(void *data, void *arg), void *arg, int nthreads)
 {
-  int position, i;
- 
-  /* Use double hashing to hash the key */
-  for (i = 0; i < htbl->positions; i++)
+  struct OHtblRange_ range[OHTBL_MAXTHREADS];
+#ifndef _WIN32
+  pthread_t thread[OHTBL_MAXTHREADS];
+  int started[OHTBL_MAXTHREADS];
+#endif
+  int i;
+
+  if (nthreads > OHTBL_MAXTHREADS)
+    nthreads = OHTBL_MAXTHREADS;
+
+  if (nthreads > htbl->positions)
+    nthreads = htbl->positions;
+
+  if (nthreads < 1)
+    nthreads = 1;
+
+  /* Split the positions into ranges of (almost) equal size */
+  for (i = 0; i < nthreads; i++)
+    {
+      range[i].htbl = htbl;
+      range[i].from = (int)((double)htbl->positions * i / nthreads);
+      range[i].to = (int)((double)htbl->positions * (i + 1) / nthreads);
+      range[i].callback = callback;
+      range[i].arg = arg;
+    }
+
+#ifndef _WIN32
+  /* One range is left for the calling thread */
+  for (i = 1; i < nthreads; i++)
+    started[i] = pthread_create(&thread[i], NULL, foreach_range, &range[i]) == 0;
+
+  foreach_range(&range[0]);
+
+  for (i = 1; i < nthreads; i++)
     {
-      position = (htbl->h1(*data) + (i * htbl->h2(*data))) % htbl->positions;
+      if (started[i])
+        pthread_join(thread[i], NULL);
+      else
+        foreach_range(&range[i]);
+    }
+#else
+  for (i = 0; i < nthreads; i++)
+    foreach_range(&range[i]);
+#endif
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static int insert_hashed(OHtbl htbl, const void *data, unsigned int hash1, unsigned int hash2) --- */
+static int insert_hashed(OHtbl htbl, const void *data, unsigned int hash1, unsigned int hash2)
+{
+  int position, freepos = -1;
+
+  /* Do nothing if the data is already in the table - probe before growing,
+     so a duplicate never costs a rehash */
+  if (htbl->probing == OHTBL_ROBINHOOD)
+    position = rh_probe(htbl, data, hash1);
+  else
+    position = probe(htbl, data, hash1, hash2, &freepos);
+
+  if (position >= 0) /* Duplicate found! */
+    return 1;
 
-      if (htbl->table[position] == NULL) 
+  /* Grow - or purge vacated positions - before the max. load factor is exceeded */
+  if (htbl->maxload > 0.0 && htbl->size + htbl->vacancies + 1 > htbl->maxload * htbl->positions)
+    {
+      if (grow(htbl) == 0)
         {
-          /* Return that the data was not found */
+          /* The elements have moved - find the first free position again */
+          if (htbl->probing == OHTBL_DOUBLE)
+            probe(htbl, data, hash1, hash2, &freepos);
+        }
+      else if (htbl->size == htbl->positions)
+        return -1;
+    }
+
+  /* Do not exceed the number of positions in the table */
+  if (htbl->size == htbl->positions)
+    return -1;
+
+  if (htbl->probing == OHTBL_ROBINHOOD)
+    {
+      rh_insert(htbl, (void *)data, hash1);
+      htbl->size++;
+      return 0;
+    }
+
+  /* The probe sequence did not reach a free position - grow, if allowed, and retry */
+  if (freepos < 0 && htbl->maxload > 0.0 && rebuild(htbl, next_prime(2 * htbl->positions)) == 0)
+    probe(htbl, data, hash1, hash2, &freepos);
+
+  /* Return that the hash functions were selected incorrectly */
+  if (freepos < 0)
+    return -1;
+
+  /* Insert the data into the first free position of the probe sequence */
+  if (htbl->table[freepos] == htbl->vacated)
+    htbl->vacancies--;
+
+  htbl->table[freepos] = (void *)data;
+  htbl->hashes[freepos] = hash1;
+  htbl->size++;
+
+  return 0;
+}
+
+/* --- Function: static int lookup_hashed(OHtbl htbl, const void *key, unsigned int hash1, unsigned int hash2) --- */
+static int lookup_hashed(OHtbl htbl, const void *key, unsigned int hash1, unsigned int hash2)
+{
+  int freepos;
+
+  if (htbl->probing == OHTBL_ROBINHOOD)
+    return rh_probe(htbl, key, hash1);
+
+  return probe(htbl, key, hash1, hash2, &freepos);
+}
+
+/* --- Function: static void hash_group(OHtbl htbl, const void **keys, int cnt, unsigned int *hash1, unsigned int *hash2) --- */
+static void hash_group(OHtbl htbl, const void **keys, int cnt, unsigned int *hash1, unsigned int *hash2)
+{
+  int j, position;
+
+  for (j = 0; j < cnt; j++)
+    {
+      hash1[j] = (unsigned int)htbl->h1(keys[j]);
+      hash2[j] = htbl->probing == OHTBL_DOUBLE ? (unsigned int)htbl->h2(keys[j]) : 0;
+
+      /* Both the data reference and the hash tag are read at the home position */
+      position = (int)(hash1[j] % (unsigned int)htbl->positions);
+      OHTBL_PREFETCH(&htbl->table[position]);
+      OHTBL_PREFETCH(&htbl->hashes[position]);
+    }
+}
+
+/* --- Function: static int probe(OHtbl htbl, const void *key, unsigned int hash1, unsigned int hash2, int *freepos) --- */
+static int probe(OHtbl htbl, const void *key, unsigned int hash1, unsigned int hash2, int *freepos)
+{
+  unsigned int position, step;
+  int i;
+
+  /* Use double hashing - position = (h1 + i*h2) % positions - computed
+     incrementally, so the hash functions are called once only */
+  position = hash1 % (unsigned int)htbl->positions;
+  step = hash2 % (unsigned int)htbl->positions;
+  *freepos = -1;
+
+  /* A step of zero would probe the same position over and over again */
+  if (step == 0)
+    step = 1;
+
+  for (i = 0; i < htbl->positions; i++)
+    {
+      if (htbl->table[position] == NULL)
+        {
+          /* Data not found - first free position is here - unless a vacated one came before */
+          if (*freepos < 0)
+            *freepos = (int)position;
           return -1;
         }
       else if (htbl->table[position] == htbl->vacated) 
         {
-          /* Search beyond vacated positions */
-          continue;
+          /* Remember the first vacated position - and search beyond it */
+          if (*freepos < 0)
+            *freepos = (int)position;
         }
-      else if (htbl->match(htbl->table[position], *data))
+      else if (htbl->hashes[position] == hash1 && htbl->match(htbl->table[position], key))
         {
-          /* Pass back the data from the table */
-          *data = htbl->table[position];
-          htbl->table[position] = htbl->vacated;
-          htbl->size--;
-          return 0;
+          /* Data found - only matched when the hash tags agree */
+          return (int)position;
         }
+
+      position = (position + step) % (unsigned int)htbl->positions;
     }
 
-  /* Return that the data was not found */
+  /* Data not found... */
   return -1;
 }
 
-int OHTBLlookup(const OHtbl htbl, void **data)
+/* --- Function: static int rh_distance(OHtbl htbl, int position) --- */
+static int rh_distance(OHtbl htbl, int position)
 {
-  int position, i;
- 
-  /* Use double hashing to hash the key */
-  for (i = 0; i < htbl->positions; i++) 
+  int home;
+
+  /* Distance from the home position of the element - to where it is stored */
+  home = (int)(htbl->hashes[position] % (unsigned int)htbl->positions);
+
+  return position >= home ? position - home : position + htbl->positions - home;
+}
+
+/* --- Function: static int rh_probe(OHtbl htbl, const void *key, unsigned int hash) --- */
+static int rh_probe(OHtbl htbl, const void *key, unsigned int hash)
+{
+  int position, dist;
+
+  position = (int)(hash % (unsigned int)htbl->positions);
+
+  for (dist = 0; dist < htbl->positions; dist++)
     {
-      position = (htbl->h1(*data) + (i * htbl->h2(*data))) % htbl->positions;
+      /* An empty position - or an element closer to its home than the key 
+         would be - ends the search. Robin Hood keeps the elements ordered so. */
+      if (htbl->table[position] == NULL || rh_distance(htbl, position) < dist)
+        return -1;
 
-      if (htbl->table[position] == NULL)
+      if (htbl->hashes[position] == hash && htbl->match(htbl->table[position], key))
+        return position;
+
+      if (++position == htbl->positions)
+        position = 0;
+    }
+
+  return -1;
+}
+
+/* --- Function: static void rh_insert(OHtbl htbl, void *data, unsigned int hash) --- */
+static void rh_insert(OHtbl htbl, void *data, unsigned int hash)
+{
+  int position, dist, tmpdist;
+  unsigned int tmphash;
+  void *tmp;
+
+  position = (int)(hash % (unsigned int)htbl->positions);
+  dist = 0;
+
+  /* There is at least one free position - the caller has checked */
+  while (htbl->table[position] != NULL)
+    {
+      /* Take from the rich - an element closer to home gives way */
+      if ((tmpdist = rh_distance(htbl, position)) < dist)
         {
-          /* Return that the data was not found */
-          return -1;
+          tmp = htbl->table[position];
+          tmphash = htbl->hashes[position];
+          htbl->table[position] = data;
+          htbl->hashes[position] = hash;
+          data = tmp;
+          hash = tmphash;
+          dist = tmpdist;
         }
-      else if (htbl->match(htbl->table[position], *data)) 
+
+      if (++position == htbl->positions)
+        position = 0;
+      dist++;
+    }
+
+  htbl->table[position] = data;
+  htbl->hashes[position] = hash;
+}
+
+/* --- Function: static void rh_remove(OHtbl htbl, int position) --- */
+static void rh_remove(OHtbl htbl, int position)
+{
+  int next;
+
+  /* Backward-shift deletion - no vacated positions are left behind */
+  while (1)
+    {
+      next = position + 1 == htbl->positions ? 0 : position + 1;
+
+      if (htbl->table[next] == NULL || rh_distance(htbl, next) == 0)
+        break;
+
+      htbl->table[position] = htbl->table[next];
+      htbl->hashes[position] = htbl->hashes[next];
+      position = next;
+    }
+
+  htbl->table[position] = NULL;
+}
+
+/* --- Function: static int rebuild(OHtbl htbl, int positions) --- */
+static int rebuild(OHtbl htbl, int positions)
+{
+  void **oldtable, *data;
+  unsigned int *oldhashes, position, step;
+  int oldpositions, i, j;
+
+  oldtable = htbl->table;
+  oldhashes = htbl->hashes;
+  oldpositions = htbl->positions;
+
+  /* Allocate the new table - and the hash tags */
+  if ((htbl->table = (void **)ALLOCATOR_MALLOC(htbl->alloc, positions * sizeof(void *))) == NULL)
+    {
+      htbl->table = oldtable;
+      return -1;
+    }
+
+  if ((htbl->hashes = (unsigned int *)ALLOCATOR_MALLOC(htbl->alloc, positions * sizeof(unsigned int))) == NULL)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl->table);
+      htbl->table = oldtable;
+      htbl->hashes = oldhashes;
+      return -1;
+    }
+
+  for (i = 0; i < positions; i++)
+    htbl->table[i] = NULL;
+
+  htbl->positions = positions;
+
+  /* Reinsert all elements - vacated positions are purged. The cached hash tags are 
+     reused - only h2() has to be called, for the step size of double hashing */
+  for (i = 0; i < oldpositions; i++)
+    {
+      data = oldtable[i];
+
+      if (data == NULL || data == htbl->vacated)
+        continue;
+
+      if (htbl->probing == OHTBL_ROBINHOOD)
         {
-          /* Pass back the data from the table */
-          *data = htbl->table[position];
-          return 0;
+          rh_insert(htbl, data, oldhashes[i]);
+          continue;
+        }
+
+      position = oldhashes[i] % (unsigned int)positions;
+      step = (unsigned int)htbl->h2(data) % (unsigned int)positions;
+
+      if (step == 0)
+        step = 1;
+
+      for (j = 0; j < positions && htbl->table[position] != NULL; j++)
+        position = (position + step) % (unsigned int)positions;
+
+      if (j == positions)
+        {
+          /* No free position in the probe sequence - keep the old table */
+          ALLOCATOR_FREE(htbl->alloc, htbl->table);
+          ALLOCATOR_FREE(htbl->alloc, htbl->hashes);
+          htbl->table = oldtable;
+          htbl->hashes = oldhashes;
+          htbl->positions = oldpositions;
+          return -1;
         }
+
+      htbl->table[position] = data;
+      htbl->hashes[position] = oldhashes[i];
     }
 
-  /* Return that the data was not found... */
-  return -1;
+  htbl->vacancies = 0;
+
+  ALLOCATOR_FREE(htbl->alloc, oldtable);
+  ALLOCATOR_FREE(htbl->alloc, oldhashes);
+
+  return 0;
 }
 
-int OHTBLsize(OHtbl htbl)
+/* --- Function: static int grow(OHtbl htbl) --- */
+static int grow(OHtbl htbl)
 {
-  return htbl->size;
+  /* Mostly vacated positions - a rehash at the current size is enough */
+  if (htbl->size + 1 <= htbl->maxload * htbl->positions / 2)
+    return rebuild(htbl, htbl->positions);
+
+  /* A prime number of positions keeps all double hashing step sizes usable */
+  if (htbl->probing == OHTBL_DOUBLE)
+    return rebuild(htbl, next_prime(2 * htbl->positions));
+
+  return rebuild(htbl, 2 * htbl->positions);
 }
 
-void OHTBLprint(OHtbl htbl, void (*callback)(const void *data))
+/* --- Function: static int next_prime(int n) --- */
+static int next_prime(int n)
 {
   int i;
 
-  for (i=0; i<htbl->positions; i++)
+  if (n <= 2)
+    return 2;
+
+  if (n % 2 == 0)
+    n++;
+
+  for (;; n += 2)
     {
-      if (htbl->table[i] == NULL)
-        printf("\nNULL");
-      else if (htbl->table[i] == htbl->vacated)
-        printf("\nVACATED");
-      else
-        callback(htbl->table[i]);
+      for (i = 3; i <= n / i; i += 2)
+        {
+          if (n % i == 0)
+            break;
+        }
+
+      if (i > n / i)
+        return n;
+    }
+}
+
+/* --- Function: static void *foreach_range(void *range) --- */
+static void *foreach_range(void *range)
+{
+  struct OHtblRange_ *rp = (struct OHtblRange_ *)range;
+  void *data;
+  int i;
+
+  for (i = rp->from; i < rp->to; i++)
+    {
+      data = rp->htbl->table[i];
+
+      if (data != NULL && data != rp->htbl->vacated)
+        rp->callback(data, rp->arg);
     }
+
+  return NULL;
 }
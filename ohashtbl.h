@@ -13,6 +13,11 @@
  * 
  * Date   Revision message
  * 150331 This code ready for version 0.51
+ * 261017 Keys are now hashed once only, per operation.
+ * 261017 Added Robin Hood probing - selectable by the new function OHTBLinit_ex().
+ * 261017 Added automatic growth - see OHTBLsetloadfactor(), OHTBLrehash() and OHTBLpositions().
+ * 261017 Added batch functions - OHTBLinsert_batch() and OHTBLlookup_batch().
+ * 261017 Added iteration - OHTBLfirst(), OHTBLnext() - and OHTBLforeach().
  *
  */
 /**
@@ -30,6 +35,20 @@
 extern "C" {
 #endif
 
+  /**
+   * Macro for selecting the probing strategy of the table - 
+   * double hashing, with @a vacated positions left behind by
+   * removals (=the default strategy)
+   * 
+   **/
+#define OHTBL_DOUBLE 0
+  /**
+   * Macro for selecting the probing strategy of the table - 
+   * Robin Hood linear probing, with backward-shift deletion
+   * 
+   **/
+#define OHTBL_ROBINHOOD 1
+
   /**
    * Use a @b typedef - to hide the interior of @b OHtbl_ - in the 
    * implementation file. This is how @a data @a hiding can be done in C.
@@ -37,6 +56,20 @@ extern "C" {
    **/
   typedef struct OHtbl_ *OHtbl;
 
+  /**
+   * A cursor - for iterating over all elements of a table
+   *
+   * Declare one - on the stack, for example - and pass a reference
+   * to it to @b OHTBLfirst() and @b OHTBLnext(). The members are
+   * private to the implementation.
+   *
+   **/
+  typedef struct OHtblIter_
+  {
+    int position;  /* Current position */
+    int left;      /* Number of elements not visited yet */
+  } OHtblIter;
+
   /* FUNCTION DECLARATIONS */
 
   /**
@@ -52,7 +85,9 @@ extern "C" {
    * parameter - given to function @b h2()  - when called.
    * @param[in] match - A reference to a user-defined @a match 
    * function. This function shall return 1 - if @a key1 is equal 
-   * to @a key2 - or 0 otherwise.
+   * to @a key2 - or 0 otherwise. The value of @b h1() is stored 
+   * with every element - and @a match is only called for elements 
+   * with the same @b h1() value as the searched key.
    * @param[in] destroy - A reference to a user-defined function,
    * reponsible for freeing @a element @a data, when the table is 
    * destroyed. If @a destroy is set to NULL - then element data will 
@@ -63,11 +98,48 @@ extern "C" {
    * as a parameter in subsequent calls - to the majority of other
    * table functions in this function interface - i.e. a sort
    * of "handle" to the table.
-   * @see OHTBLdestroy()
+   * @see OHTBLdestroy(), OHTBLinit_ex()
    **/
   OHtbl OHTBLinit(int positions, int (*h1)(const void *key), int (*h2)(const void *key),
                   int (*match)(const void *key1, const void *key2), void (*destroy)(void *data));
 
+  /**
+   * Initialize the open-addressed hash table - with a selectable
+   * probing strategy
+   * 
+   * Works like @b OHTBLinit() - but lets you choose how colliding
+   * keys are placed in the table:
+   * - @b OHTBL_DOUBLE - double hashing, using both @a h1 and @a h2.
+   * A removed element leaves a @a vacated position behind, which
+   * lookups must probe past. Same as @b OHTBLinit().
+   * - @b OHTBL_ROBINHOOD - linear probing from position @a h1 - 
+   * where an element further from its home position takes over the 
+   * position of an element closer to home, upon insertion. A removal 
+   * shifts the following elements one step back, so there will be no
+   * @a vacated positions. Lookup cost stays bounded - also after heavy
+   * insert/remove churn. The @a h2 function is not used, and may be NULL.
+   *
+   * @param[in] positions - The number of positions you want the
+   * table to contain when created.
+   * @param[in] h1 - A reference to a user-defined hash function. 
+   * @param[in] h2 - A reference to a user-defined hash function - 
+   * for the step size of double hashing.
+   * @param[in] match - A reference to a user-defined @a match 
+   * function.
+   * @param[in] destroy - A reference to a user-defined function,
+   * reponsible for freeing @a element @a data, when the table is 
+   * destroyed - or NULL.
+   * @param[in] probing - @b OHTBL_DOUBLE or @b OHTBL_ROBINHOOD.
+   * @return A reference - to a new, empty table - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise (also 
+   * returned for an unknown @a probing strategy - or a missing @a h2
+   * for double hashing).
+   * @see OHTBLinit()
+   **/
+  OHtbl OHTBLinit_ex(int positions, int (*h1)(const void *key), int (*h2)(const void *key),
+                     int (*match)(const void *key1, const void *key2), void (*destroy)(void *data),
+                     int probing);
+
   /**
    * Destroy the hash table
    * 
@@ -95,6 +167,9 @@ extern "C" {
    * ensure, that this memory is valid as long as it is present in the 
    * table.
    *
+   * If a max. load factor has been set by @b OHTBLsetloadfactor(),
+   * the table grows automatically - instead of running full.
+   *
    * @param[in] htbl - a reference to current table.
    * @param[in] data - a reference to data to be inserted into
    * the table.
@@ -104,6 +179,27 @@ extern "C" {
    **/
   int OHTBLinsert(OHtbl htbl, const void *data);
 
+  /**
+   * Insert an array of data elements into the table
+   * 
+   * Works like calling @b OHTBLinsert() for each element of the 
+   * array @a data - in order. The keys are processed in small groups:
+   * all keys of a group are hashed, and their home positions are 
+   * prefetched, before the insertions are done. This way, the cache
+   * misses of many keys overlap - instead of being taken one at a time.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] data - an array of @a n references to data, to
+   * be inserted into the table.
+   * @param[in] n - the number of elements in @a data.
+   * @param[out] results - an array of @a n return values - one per
+   * element, with the same meaning as the return value of
+   * @b OHTBLinsert() - or NULL, if not wanted.
+   * @return The number of elements actually inserted.
+   * @see OHTBLinsert()
+   **/
+  int OHTBLinsert_batch(OHtbl htbl, const void **data, int n, int *results);
+
   /**
    * Remove a data element from the table
    * 
@@ -164,6 +260,29 @@ extern "C" {
    **/
   int OHTBLlookup(const OHtbl htbl, void **data);
 
+  /**
+   * Determine if an array of data elements exists in the table
+   * 
+   * Works like calling @b OHTBLlookup() for each element of the
+   * array @a data. The keys are processed in small groups: all keys
+   * of a group are hashed, and their home positions are prefetched,
+   * before the lookups are done - so the cache misses of many keys
+   * overlap.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in,out] data - an array of @a n pointers, pointing at
+   * the data to be searched for - at the call. Upon return - every
+   * pointer with a hit, has been redirected to point to data in the
+   * element hit. The other pointers are left untouched.
+   * @param[in] n - the number of elements in @a data.
+   * @param[out] results - an array of @a n return values - one per
+   * element, with the same meaning as the return value of
+   * @b OHTBLlookup() - or NULL, if not wanted.
+   * @return The number of elements found.
+   * @see OHTBLlookup()
+   **/
+  int OHTBLlookup_batch(const OHtbl htbl, void **data, int n, int *results);
+
   /**
    * Get the size of the table
    * 
@@ -174,6 +293,60 @@ extern "C" {
    **/
   int OHTBLsize(OHtbl htbl);
 
+  /**
+   * Get the number of positions in the table
+   * 
+   * @param[in] htbl - a reference to the current table.
+   *
+   * @return The number of positions in the table.
+   **/
+  int OHTBLpositions(OHtbl htbl);
+
+  /**
+   * Turn automatic growth of the table on - or off
+   * 
+   * When an insertion would make the number of occupied - and 
+   * @a vacated - positions exceed @a maxload times the number of
+   * positions, the table is rehashed. If mostly @a vacated positions
+   * are to blame, the table keeps its size - otherwise it is doubled 
+   * (for double hashing - to the next prime number above). The table 
+   * is also grown if the double hashing probe sequence of a new key
+   * finds no free position. Vacated positions are purged on every 
+   * rehash.
+   * @b Note: The function @b h2() is called once per element during
+   * a rehash - so it must not depend on a fixed number of positions. 
+   * The @b h1() value is never recomputed.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] maxload - max. load factor, in the range (0, 1]. 
+   * A value <= 0 means a fixed size table (=default).
+   *
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - if @a maxload was out of range.
+   * @see OHTBLrehash()
+   **/
+  int OHTBLsetloadfactor(OHtbl htbl, double maxload);
+
+  /**
+   * Rehash the table - explicitly
+   * 
+   * Rebuilds the table with @a positions positions - purging all
+   * @a vacated positions - to restore the probe performance 
+   * after many removals. The table is left unchanged if the call
+   * fails.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] positions - the new number of positions. A value
+   * <= 0 keeps the current number of positions.
+   *
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise - i.e. too few positions for the 
+   * elements, out of memory, or no free position was found in the
+   * double hashing probe sequence of some element.
+   * @see OHTBLsetloadfactor()
+   **/
+  int OHTBLrehash(OHtbl htbl, int positions);
+
   /**
    * Print all data of the open-addressed hash table -
    *  on screen
@@ -191,6 +364,66 @@ extern "C" {
    **/
   void OHTBLprint(OHtbl htbl, void (*callback)(const void *data));
 
+  /**
+   * Get the first element of the table - when iterating
+   *
+   * Starts an iteration over all elements of the table - in no
+   * particular order. Empty and vacated positions are skipped - and
+   * the iteration ends as soon as the last element has been visited,
+   * without scanning the remaining positions. The table must not be
+   * modified until the iteration is finished.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[out] iter - a reference to a cursor - set up by this call,
+   * for subsequent calls to @b OHTBLnext().
+   * @param[out] data - a reference to a pointer - redirected to the
+   * data of the first element, upon return.
+   *
+   * @return Value 0 - if an element was found.\n
+   *         Value -1 - if the table is empty.
+   * @see OHTBLnext()
+   **/
+  int OHTBLfirst(OHtbl htbl, OHtblIter *iter, void **data);
+
+  /**
+   * Get the next element of the table - when iterating
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in,out] iter - a reference to a cursor - set up by
+   * @b OHTBLfirst().
+   * @param[out] data - a reference to a pointer - redirected to the
+   * data of the next element, upon return.
+   *
+   * @return Value 0 - if an element was found.\n
+   *         Value -1 - if all elements have been visited.
+   * @see OHTBLfirst()
+   **/
+  int OHTBLnext(OHtbl htbl, OHtblIter *iter, void **data);
+
+  /**
+   * Visit all elements of the table - in parallel
+   *
+   * The positions are split into @a nthreads ranges of equal size -
+   * each one scanned by a thread of its own, calling @a callback for
+   * every element in the range. The calling thread scans one of the
+   * ranges itself - and this function returns when all of them are
+   * done. The table must not be modified during the call, and the
+   * callback must be thread-safe. On platforms without POSIX threads
+   * - or if a thread cannot be started - the ranges are scanned by
+   * the calling thread.
+   *
+   * @param[in] htbl - a reference to the current table.
+   * @param[in] callback - reference to a user-defined function, called
+   * with the data of each element - and @a arg.
+   * @param[in] arg - passed on to @a callback - untouched.
+   * @param[in] nthreads - the number of threads to use. A value less
+   * than 2 scans the table in the calling thread only.
+   *
+   * @return Nothing.
+   * @see OHTBLfirst()
+   **/
+  void OHTBLforeach(OHtbl htbl, void (*callback)(void *data, void *arg), void *arg, int nthreads);
+
 #ifdef __cplusplus
 }
 #endif 
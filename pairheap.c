@@ -0,0 +1,295 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: pairheap.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 15:10:22 2026
+ * Version : 0.51
+ * ---
+ * Description: A pairing heap ADT - written in ANSI C.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ *
+ */
+
+/**
+ * @file pairheap.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pairheap.h"
+#include "allocator.h"
+
+/**
+ * Macro for level separation when calling PAIRHEAPprint()
+ *
+ * This macro sets the distance - measured in column
+ * positions - between node levels of the tree when
+ * it is printed on screen.
+ **/
+#define PAIRHEAP_PRINT_LEVEL_PADDING 4
+
+struct PairHeapNode_ {
+  void                 *data;
+  struct PairHeapNode_ *child;    /* First (leftmost) child */
+  struct PairHeapNode_ *sibling;  /* Next sibling - to the right */
+};
+
+struct PairHeap_ {
+  int   size;
+  int  (*compare)(const void *key1, const void *key2);
+  void (*destroy)(void *data);
+  struct PairHeapNode_ *root;
+  const Allocator      *alloc;
+};
+
+/* STATIC FUNCTION DECLARATIONS */
+static struct PairHeapNode_ *join(PairHeap ph, struct PairHeapNode_ *a, struct PairHeapNode_ *b);
+static struct PairHeapNode_ *combine(PairHeap ph, struct PairHeapNode_ *first);
+
+
+/* --- PUBLIC FUNCTION DEFINITIONS --- */
+/* --- Function: PairHeap PAIRHEAPinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data)) --- */
+PairHeap PAIRHEAPinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data))
+{
+  PairHeap ph;
+  const Allocator *alloc = ALLOCATORget();
+
+  if ((ph = (PairHeap)ALLOCATOR_MALLOC(alloc, sizeof(struct PairHeap_))) == NULL)
+    return NULL;
+
+  ph->size = 0;
+  ph->compare = compare;
+  ph->destroy = destroy;
+  ph->root = NULL;
+  ph->alloc = alloc;
+
+  return ph;
+}
+
+/* --- Function: void PAIRHEAPdestroy(PairHeap ph) --- */
+void PAIRHEAPdestroy(PairHeap ph)
+{
+  struct PairHeapNode_ *node, *tail, *next;
+
+  /* Walk all nodes - without recursion, since the tree may be very deep. The
+     child list of every node visited is appended to the list of nodes to visit */
+  for (node = tail = ph->root; node != NULL; node = next)
+    {
+      if (node->child != NULL)
+        {
+          tail->sibling = node->child;
+
+          while (tail->sibling != NULL)
+            tail = tail->sibling;
+        }
+
+      next = node->sibling;
+
+      if (ph->destroy != NULL)
+        ph->destroy(node->data);
+
+      ALLOCATOR_FREE(ph->alloc, node);
+    }
+
+  ALLOCATOR_FREE(ph->alloc, ph);
+}
+
+/* --- Function: int PAIRHEAPinsert(PairHeap ph, const void *data) --- */
+int PAIRHEAPinsert(PairHeap ph, const void *data)
+{
+  struct PairHeapNode_ *node;
+
+  if ((node = (struct PairHeapNode_ *)ALLOCATOR_MALLOC(ph->alloc, sizeof(struct PairHeapNode_))) == NULL)
+    return -1;
+
+  node->data = (void *)data;
+  node->child = NULL;
+  node->sibling = NULL;
+
+  /* A single-node tree - linked with the root */
+  ph->root = ph->root != NULL ? join(ph, ph->root, node) : node;
+  ph->size++;
+
+  return 0;
+}
+
+/* --- Function: const void *PAIRHEAPpeek(PairHeap ph) --- */
+const void *PAIRHEAPpeek(PairHeap ph)
+{
+  return ph->root != NULL ? ph->root->data : NULL;
+}
+
+/* --- Function: int PAIRHEAPextract(PairHeap ph, void **data) --- */
+int PAIRHEAPextract(PairHeap ph, void **data)
+{
+  struct PairHeapNode_ *old;
+
+  /* Do not allow extraction from an empty heap */
+  if (ph->root == NULL)
+    return -1;
+
+  old = ph->root;
+  *data = old->data;
+
+  /* The subtrees of the old root - combined into a new tree */
+  ph->root = combine(ph, old->child);
+  ph->size--;
+
+  ALLOCATOR_FREE(ph->alloc, old);
+
+  return 0;
+}
+
+/* --- Function: int PAIRHEAPmeld(PairHeap ph1, PairHeap ph2) --- */
+int PAIRHEAPmeld(PairHeap ph1, PairHeap ph2)
+{
+  /* Nodes must be freed by the allocator - that allocated them */
+  if (ph1 == ph2 || ph1->alloc != ph2->alloc)
+    return -1;
+
+  if (ph2->root != NULL)
+    ph1->root = ph1->root != NULL ? join(ph1, ph1->root, ph2->root) : ph2->root;
+
+  ph1->size += ph2->size;
+
+  ph2->root = NULL;
+  ph2->size = 0;
+
+  return 0;
+}
+
+/* --- Function: int PAIRHEAPsize(PairHeap ph) --- */
+int PAIRHEAPsize(PairHeap ph)
+{
+  return ph->size;
+}
+
+/* --- Function: void PAIRHEAPprint(PairHeap ph, void (*callback)(const void *data)) --- */
+void PAIRHEAPprint(PairHeap ph, void (*callback)(const void *data))
+{
+  struct PairHeapNode_ **stack, *node;
+  int *levels, top, level, i;
+
+  if (ph->size == 0)
+    return;
+
+  /* Every node is pushed once - an explicit stack, since the tree may be very deep */
+  stack = (struct PairHeapNode_ **)ALLOCATOR_MALLOC(ph->alloc, ph->size * sizeof(struct PairHeapNode_ *));
+  levels = (int *)ALLOCATOR_MALLOC(ph->alloc, ph->size * sizeof(int));
+
+  if (stack == NULL || levels == NULL)
+    {
+      ALLOCATOR_FREE(ph->alloc, stack);
+      ALLOCATOR_FREE(ph->alloc, levels);
+      return;
+    }
+
+  printf("\nTree:\n");
+
+  stack[0] = ph->root;
+  levels[0] = 0;
+  top = 1;
+
+  while (top > 0)
+    {
+      top--;
+      node = stack[top];
+      level = levels[top];
+
+      for (i = 0; i < PAIRHEAP_PRINT_LEVEL_PADDING*level; i++)
+        putchar('-');
+
+      callback(node->data);
+      printf("\n");
+
+      /* The next sibling - on the same level - is printed after the subtree of this node */
+      if (node->sibling != NULL)
+        {
+          stack[top] = node->sibling;
+          levels[top++] = level;
+        }
+
+      if (node->child != NULL)
+        {
+          stack[top] = node->child;
+          levels[top++] = level + 1;
+        }
+    }
+
+  ALLOCATOR_FREE(ph->alloc, stack);
+  ALLOCATOR_FREE(ph->alloc, levels);
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static struct PairHeapNode_ *join(PairHeap ph, struct PairHeapNode_ *a, struct PairHeapNode_ *b) --- */
+static struct PairHeapNode_ *join(PairHeap ph, struct PairHeapNode_ *a, struct PairHeapNode_ *b)
+{
+  struct PairHeapNode_ *tmp;
+
+  /* The root of lower priority - becomes the first child of the other */
+  if (ph->compare(b->data, a->data) > 0)
+    {
+      tmp = a;
+      a = b;
+      b = tmp;
+    }
+
+  b->sibling = a->child;
+  a->child = b;
+  a->sibling = NULL;
+
+  return a;
+}
+
+/* --- Function: static struct PairHeapNode_ *combine(PairHeap ph, struct PairHeapNode_ *first) --- */
+static struct PairHeapNode_ *combine(PairHeap ph, struct PairHeapNode_ *first)
+{
+  struct PairHeapNode_ *pairs, *a, *b, *next;
+
+  /* 1st pass - link the trees pairwise, left to right. The resulting trees
+     are pushed onto a list - in reverse order - through their sibling links */
+  pairs = NULL;
+
+  while (first != NULL)
+    {
+      a = first;
+      b = a->sibling;
+
+      if (b == NULL)
+        {
+          a->sibling = pairs;
+          pairs = a;
+          break;
+        }
+
+      next = b->sibling;
+      a = join(ph, a, b);
+      a->sibling = pairs;
+      pairs = a;
+      first = next;
+    }
+
+  /* 2nd pass - link the trees into one, right to left */
+  if (pairs == NULL)
+    return NULL;
+
+  a = pairs;
+  pairs = pairs->sibling;
+  a->sibling = NULL;
+
+  while (pairs != NULL)
+    {
+      next = pairs->sibling;
+      a = join(ph, a, pairs);
+      pairs = next;
+    }
+
+  return a;
+}
@@ -0,0 +1,154 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: pairheap.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 15:10:22 2026
+ * Version : 0.51
+ * ---
+ * Description: A pairing heap ADT - written in ANSI C.
+ *
+ * Revision history - coming up below:
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ *
+ */
+/**
+ * @file pairheap.h
+ **/
+
+#ifndef _PAIRHEAP_H_
+#define _PAIRHEAP_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Use a @b typedef - to hide the interior of @b PairHeap_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct PairHeap_ *PairHeap;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Initiate the pairing heap
+   *
+   * A pairing heap is a tree - where every node has a higher priority
+   * than (or equal to) its children - with any number of children per
+   * node. Insertion and melding of two heaps take O(1) time - they
+   * just link two trees. Extraction takes O(log n) amortized time -
+   * the children of the old top are linked pairwise, and then into
+   * a single tree.
+   * @param[in] compare - a reference to a user-defined function,
+   * used to compare elements - see @b HEAPinit().
+   * @param[in] destroy - a reference to a user-defined function,
+   * reponsible for freeing @a element @a data, when the heap is
+   * destroyed. If @a destroy is set to NULL - then element data will
+   * be left untouched upon heap destruction.
+   * @return A reference - to a new, empty heap - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise. Take
+   * really good care of this return value, since it will be needed
+   * as a parameter in subsequent calls - to the majority of other
+   * heap functions in this function interface - i.e. a sort of
+   * "handle" to the heap.
+   * @see PAIRHEAPdestroy()
+   **/
+  PairHeap PAIRHEAPinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data));
+
+  /**
+   * Destroy the pairing heap
+   *
+   * All nodes are freed - and their data handed over to @a destroy,
+   * if set by @b PAIRHEAPinit().
+   * @param[in] ph - a reference to current heap.
+   * @return Nothing.
+   * @see PAIRHEAPinit()
+   **/
+  void PAIRHEAPdestroy(PairHeap ph);
+
+  /**
+   * Insert data into the pairing heap
+   *
+   * Takes O(1) time.
+   * @param[in] ph - a reference to current heap.
+   * @param[in] data - a reference to data to be inserted into
+   * the heap.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value -1 - otherwise.
+   **/
+  int PAIRHEAPinsert(PairHeap ph, const void *data);
+
+  /**
+   * Inspect the top-priority element of the pairing heap
+   *
+   * @param[in] ph - a reference to current heap.
+   * @return A reference to the top-priority element of the heap - or
+   * NULL if the heap is empty.
+   **/
+  const void *PAIRHEAPpeek(PairHeap ph);
+
+  /**
+   * Remove data from the top of the pairing heap
+   *
+   * @param[in] ph - reference to current heap.
+   * @param[out] data - reference to a pointer. After the call,
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful. The caller is responsible for the future of
+   * this memory - deallocating it, for example.
+   * @return Value 0 --  if the call was OK - that is, element
+   * removed.\n
+   *         Value -1 -- otherwise (empty heap).
+   **/
+  int PAIRHEAPextract(PairHeap ph, void **data);
+
+  /**
+   * Move all elements of one pairing heap into another
+   *
+   * Takes O(1) time. @a ph2 is left empty, but not destroyed. Both
+   * heaps must have the same @a compare function.
+   * @param[in] ph1 - a reference to the heap to insert into.
+   * @param[in] ph2 - a reference to the heap to take the elements
+   * from.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - if @a ph1 and @a ph2 is the same heap.
+   **/
+  int PAIRHEAPmeld(PairHeap ph1, PairHeap ph2);
+
+  /**
+   * Get the size of the pairing heap
+   *
+   * @param[in] ph - a reference to the current heap.
+   * @return The size, that is, the number of elements
+   * in the heap.
+   **/
+  int PAIRHEAPsize(PairHeap ph);
+
+  /**
+   * Print the pairing heap on screen
+   *
+   * The heap is printed as a tree - one node per line, each child
+   * indented under its parent.
+   * @param[in] ph - reference to current heap.
+   * @param[in] callback - reference to user-defined callback function,
+   * that gets @b read @b access to element data via its parameter
+   * @a data - to do whatever is relevant.
+   * @return Nothing.
+   **/
+  void PAIRHEAPprint(PairHeap ph, void (*callback)(const void *data));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PAIRHEAP_H_ */
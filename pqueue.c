@@ -13,6 +13,17 @@
  * 
  * Date   Revision message
  * 150331 This code ready for version 0.51
+ * 261017 Added PQUEUEreserve().
+ * 261017 Added PQUEUEbuild() and PQUEUEadopt().
+ * 261017 Added PQUEUEinsert_handle(), PQUEUEupdate() and PQUEUEremove().
+ * 261017 Added PQUEUEreplace(), PQUEUEpushpop() and PQUEUEextract_n().
+ * 261017 Added PQUEUEinit_ex() - with a pairing heap and a radix heap as alternative
+ *        engines to the binary heap - and PQUEUEmeld(). PQueue is now a type of its own.
+ * 261017 Added PQUEUEsettopk().
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ * 261017 PQUEUEreplace() now passes on -2 from PQUEUEextract() - out of memory, with PQUEUE_RADIX.
+ * 261017 Added PQUEUEinit_arity() - for binary heap engines with more than 2 children per node.
+ * 261017 Added PQUEUEreplace_handle() and PQUEUEpushpop_handle().
  *
  */
 
@@ -24,46 +35,362 @@
 #include <stdlib.h>
 
 #include "pqueue.h"
+#include "pairheap.h"
+#include "radixheap.h"
+#include "allocator.h"
+
+struct PQueue_ {
+  int       engine;
+  int       (*compare)(const void *key1, const void *key2);
+  unsigned long (*key)(const void *data);
+  Heap      heap;       /* PQUEUE_BINARY */
+  PairHeap  pairing;    /* PQUEUE_PAIRING */
+  RadixHeap radix;      /* PQUEUE_RADIX */
+  const Allocator *alloc;
+};
+
+/* STATIC FUNCTION DECLARATIONS */
+static PQueue init(int (*compare)(const void *key1, const void* key2), unsigned long (*key)(const void *data), void (*destroy)(void *data), int engine, int arity);
+static int before(PQueue pq, const void *a, const void *b);
+
 
 /* --- PUBLIC FUNCTION DEFINITIONS --- */
 /* --- Function: PQueue PQUEUEinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data)) --- */
 PQueue PQUEUEinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data))
 {
-  return HEAPinit(compare, destroy);  
+  return PQUEUEinit_ex(compare, NULL, destroy, PQUEUE_BINARY);
+}
+
+/* --- Function: PQueue PQUEUEinit_ex(int (*compare)(const void *key1, const void* key2), unsigned long (*key)(const void *data), void (*destroy)(void *data), int engine) --- */
+PQueue PQUEUEinit_ex(int (*compare)(const void *key1, const void* key2), unsigned long (*key)(const void *data), void (*destroy)(void *data), int engine)
+{
+  return init(compare, key, destroy, engine, 2);
+}
+
+/* --- Function: PQueue PQUEUEinit_arity(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data), int arity) --- */
+PQueue PQUEUEinit_arity(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data), int arity)
+{
+  return init(compare, NULL, destroy, PQUEUE_BINARY, arity);
 }
 
 /* --- Function: void PQUEUEdestroy(PQueue pq) --- */
 void PQUEUEdestroy(PQueue pq)
 {
-  HEAPdestroy(pq);
+  switch (pq->engine)
+    {
+    case PQUEUE_BINARY:
+      HEAPdestroy(pq->heap);
+      break;
+    case PQUEUE_PAIRING:
+      PAIRHEAPdestroy(pq->pairing);
+      break;
+    case PQUEUE_RADIX:
+      RADIXHEAPdestroy(pq->radix);
+      break;
+    }
+
+  ALLOCATOR_FREE(pq->alloc, pq);
 }
 
 /* --- Function:   int PQUEUEinsert(PQueue pq, const void *data) --- */
 int PQUEUEinsert(PQueue pq, const void *data)
 {
-  return HEAPinsert(pq, data);
+  switch (pq->engine)
+    {
+    case PQUEUE_PAIRING:
+      return PAIRHEAPinsert(pq->pairing, data);
+    case PQUEUE_RADIX:
+      return RADIXHEAPinsert(pq->radix, data);
+    default:
+      return HEAPinsert(pq->heap, data);
+    }
+}
+
+/* --- Function:   int PQUEUEinsert_handle(PQueue pq, const void *data, int *handle) --- */
+int PQUEUEinsert_handle(PQueue pq, const void *data, int *handle)
+{
+  /* Handles are a binary heap feature */
+  if (pq->engine != PQUEUE_BINARY)
+    return -1;
+
+  return HEAPinsert_handle(pq->heap, data, handle);
+}
+
+/* --- Function:   int PQUEUEupdate(PQueue pq, int handle) --- */
+int PQUEUEupdate(PQueue pq, int handle)
+{
+  if (pq->engine != PQUEUE_BINARY)
+    return -1;
+
+  return HEAPupdate(pq->heap, handle);
+}
+
+/* --- Function:   int PQUEUEremove(PQueue pq, int handle, void **data) --- */
+int PQUEUEremove(PQueue pq, int handle, void **data)
+{
+  if (pq->engine != PQUEUE_BINARY)
+    return -1;
+
+  return HEAPremove(pq->heap, handle, data);
 }
 
 /* --- Function:   int PQUEUEextract(PQueue pq, void **data) --- */
 int PQUEUEextract(PQueue pq, void **data)
 {
-  return HEAPextract(pq, data);
+  switch (pq->engine)
+    {
+    case PQUEUE_PAIRING:
+      return PAIRHEAPextract(pq->pairing, data);
+    case PQUEUE_RADIX:
+      return RADIXHEAPextract(pq->radix, data);
+    default:
+      return HEAPextract(pq->heap, data);
+    }
+}
+
+/* --- Function:   int PQUEUEextract_n(PQueue pq, void **data, int k) --- */
+int PQUEUEextract_n(PQueue pq, void **data, int k)
+{
+  int i;
+
+  if (pq->engine == PQUEUE_BINARY)
+    return HEAPextract_n(pq->heap, data, k);
+
+  if (k < 0)
+    return -1;
+
+  for (i = 0; i < k && PQUEUEextract(pq, &data[i]) == 0; i++)
+    ;
+
+  return i;
+}
+
+/* --- Function:   int PQUEUEreplace(PQueue pq, const void *data, void **top) --- */
+int PQUEUEreplace(PQueue pq, const void *data, void **top)
+{
+  int retval;
+
+  if (pq->engine == PQUEUE_BINARY)
+    return HEAPreplace(pq->heap, data, top);
+
+  /* The other engines have no cheaper way - than extraction and insertion */
+  if (PQUEUEsize(pq) == 0)
+    return -1;
+
+  if ((retval = PQUEUEextract(pq, top)) != 0)
+    return retval;
+
+  return PQUEUEinsert(pq, data);
+}
+
+/* --- Function:   int PQUEUEpushpop(PQueue pq, const void *data, void **top) --- */
+int PQUEUEpushpop(PQueue pq, const void *data, void **top)
+{
+  int retval;
+
+  if (pq->engine == PQUEUE_BINARY)
+    return HEAPpushpop(pq->heap, data, top);
+
+  /* New data - coming out first anyway - is passed right back */
+  if (PQUEUEsize(pq) == 0 || !before(pq, PQUEUEpeek(pq), data))
+    {
+      *top = (void *)data;
+      return 0;
+    }
+
+  if ((retval = PQUEUEinsert(pq, data)) != 0)
+    return retval;
+
+  return PQUEUEextract(pq, top);
+}
+
+/* --- Function:   int PQUEUEreplace_handle(PQueue pq, const void *data, void **top, int *handle) --- */
+int PQUEUEreplace_handle(PQueue pq, const void *data, void **top, int *handle)
+{
+  if (pq->engine != PQUEUE_BINARY)
+    return -1;
+
+  return HEAPreplace_handle(pq->heap, data, top, handle);
+}
+
+/* --- Function:   int PQUEUEpushpop_handle(PQueue pq, const void *data, void **top, int *handle) --- */
+int PQUEUEpushpop_handle(PQueue pq, const void *data, void **top, int *handle)
+{
+  if (pq->engine != PQUEUE_BINARY)
+    return -1;
+
+  return HEAPpushpop_handle(pq->heap, data, top, handle);
 }
 
 /* --- Function: void *PQUEUEpeek(const PQueue pq) --- */
 const void *PQUEUEpeek(const PQueue pq)
 {
-  return HEAPpeek(pq);
+  switch (pq->engine)
+    {
+    case PQUEUE_PAIRING:
+      return PAIRHEAPpeek(pq->pairing);
+    case PQUEUE_RADIX:
+      return RADIXHEAPpeek(pq->radix);
+    default:
+      return HEAPpeek(pq->heap);
+    }
 }
 
 /* --- Function: int PQUEUEsize(PQueue pq) --- */
 int PQUEUEsize(PQueue pq)
 {
-  return HEAPsize(pq);
+  switch (pq->engine)
+    {
+    case PQUEUE_PAIRING:
+      return PAIRHEAPsize(pq->pairing);
+    case PQUEUE_RADIX:
+      return RADIXHEAPsize(pq->radix);
+    default:
+      return HEAPsize(pq->heap);
+    }
+}
+
+/* --- Function: int PQUEUEbuild(PQueue pq, void **data, int n) --- */
+int PQUEUEbuild(PQueue pq, void **data, int n)
+{
+  int i, retval;
+
+  if (pq->engine == PQUEUE_BINARY)
+    return HEAPbuild(pq->heap, data, n);
+
+  if (n < 0)
+    return -1;
+
+  /* Insertion takes O(1) time - with the other engines */
+  for (i = 0; i < n; i++)
+    {
+      if ((retval = PQUEUEinsert(pq, data[i])) != 0)
+        return retval;
+    }
+
+  return 0;
+}
+
+/* --- Function: int PQUEUEadopt(PQueue pq, void **data, int n) --- */
+int PQUEUEadopt(PQueue pq, void **data, int n)
+{
+  int retval;
+
+  if (pq->engine == PQUEUE_BINARY)
+    return HEAPadopt(pq->heap, data, n);
+
+  if (PQUEUEsize(pq) != 0)
+    return -1;
+
+  /* No array to take over - with the other engines. Insert - and free it */
+  if ((retval = PQUEUEbuild(pq, data, n)) != 0)
+    return retval;
+
+  ALLOCATOR_FREE(pq->alloc, data);
+
+  return 0;
+}
+
+/* --- Function: int PQUEUEreserve(PQueue pq, int capacity) --- */
+int PQUEUEreserve(PQueue pq, int capacity)
+{
+  /* Nothing to reserve - with the other engines */
+  if (pq->engine != PQUEUE_BINARY)
+    return 0;
+
+  return HEAPreserve(pq->heap, capacity);
+}
+
+/* --- Function: int PQUEUEsettopk(PQueue pq, int k) --- */
+int PQUEUEsettopk(PQueue pq, int k)
+{
+  if (pq->engine != PQUEUE_BINARY)
+    return -1;
+
+  return HEAPsettopk(pq->heap, k);
+}
+
+/* --- Function: int PQUEUEmeld(PQueue pq1, PQueue pq2) --- */
+int PQUEUEmeld(PQueue pq1, PQueue pq2)
+{
+  if (pq1->engine != pq2->engine)
+    return -1;
+
+  switch (pq1->engine)
+    {
+    case PQUEUE_PAIRING:
+      return PAIRHEAPmeld(pq1->pairing, pq2->pairing);
+    case PQUEUE_RADIX:
+      return RADIXHEAPmeld(pq1->radix, pq2->radix);
+    default:
+      return HEAPmeld(pq1->heap, pq2->heap);
+    }
 }
 
 /* --- Function: void PQUEUEprint(PQueue pq, void (*callback)(const void *data)) --- */
 void PQUEUEprint(PQueue pq, void (*callback)(const void *data))
 {
-  HEAPprint(pq, callback);
+  switch (pq->engine)
+    {
+    case PQUEUE_PAIRING:
+      PAIRHEAPprint(pq->pairing, callback);
+      break;
+    case PQUEUE_RADIX:
+      RADIXHEAPprint(pq->radix, callback);
+      break;
+    default:
+      HEAPprint(pq->heap, callback);
+      break;
+    }
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static PQueue init(int (*compare)(const void *key1, const void* key2), unsigned long (*key)(const void *data), void (*destroy)(void *data), int engine, int arity) --- */
+static PQueue init(int (*compare)(const void *key1, const void* key2), unsigned long (*key)(const void *data), void (*destroy)(void *data), int engine, int arity)
+{
+  PQueue pq;
+  const Allocator *alloc = ALLOCATORget();
+
+  if ((pq = (PQueue)ALLOCATOR_MALLOC(alloc, sizeof(struct PQueue_))) == NULL)
+    return NULL;
+
+  pq->engine = engine;
+  pq->compare = compare;
+  pq->key = key;
+  pq->heap = NULL;
+  pq->pairing = NULL;
+  pq->radix = NULL;
+  pq->alloc = alloc;
+
+  switch (engine)
+    {
+    case PQUEUE_BINARY:
+      pq->heap = HEAPinit_ex(compare, destroy, arity);
+      break;
+    case PQUEUE_PAIRING:
+      pq->pairing = PAIRHEAPinit(compare, destroy);
+      break;
+    case PQUEUE_RADIX:
+      if (key != NULL)
+        pq->radix = RADIXHEAPinit(key, destroy);
+      break;
+    }
+
+  if (pq->heap == NULL && pq->pairing == NULL && pq->radix == NULL)
+    {
+      ALLOCATOR_FREE(pq->alloc, pq);
+      return NULL;
+    }
+
+  return pq;
+}
+
+/* --- Function: static int before(PQueue pq, const void *a, const void *b) --- */
+static int before(PQueue pq, const void *a, const void *b)
+{
+  /* Does 'a' come out strictly before 'b'? */
+  if (pq->engine == PQUEUE_RADIX)
+    return pq->key(a) < pq->key(b);
+
+  return pq->compare(a, b) > 0;
 }
@@ -15,6 +15,16 @@
  *
  * Date   Revision message
  * 150331 This code ready for version 0.51
+ * 261017 Added PQUEUEreserve().
+ * 261017 Added PQUEUEbuild() and PQUEUEadopt().
+ * 261017 Added PQUEUEinsert_handle(), PQUEUEupdate() and PQUEUEremove().
+ * 261017 Added PQUEUEreplace(), PQUEUEpushpop() and PQUEUEextract_n().
+ * 261017 Added PQUEUEinit_ex() and PQUEUEmeld(). PQueue is no longer just another name
+ *        for Heap - but a type of its own.
+ * 261017 Added PQUEUEsettopk().
+ * 261017 PQUEUEextract() now returns -2 - not -1 - when out of memory, with PQUEUE_RADIX.
+ * 261017 Added PQUEUEinit_arity().
+ * 261017 Added PQUEUEreplace_handle() and PQUEUEpushpop_handle().
  *
  */
 
@@ -34,7 +44,31 @@
 extern "C" {
 #endif
 
-  typedef Heap PQueue;
+  /**
+   * Macro for selecting the engine of the priority queue - a binary
+   * heap (=default)
+   * 
+   **/
+#define PQUEUE_BINARY 0
+  /**
+   * Macro for selecting the engine of the priority queue - a pairing
+   * heap
+   * 
+   **/
+#define PQUEUE_PAIRING 1
+  /**
+   * Macro for selecting the engine of the priority queue - a radix
+   * heap, for monotone unsigned integer keys
+   * 
+   **/
+#define PQUEUE_RADIX 2
+
+  /**
+   * Use a @b typedef - to hide the interior of @b PQueue_ - in the 
+   * implementation file. This is how @a data @a hiding can be done in C.
+   * 
+   **/
+  typedef struct PQueue_ *PQueue;
 
   /* --- FUNCTION DECLARATIONS --- */
   /**
@@ -63,6 +97,76 @@ extern "C" {
    **/
   PQueue PQUEUEinit(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data));
 
+  /**
+   * Initiate the priority queue - with a selectable engine
+   * 
+   * Works like @b PQUEUEinit() - but lets you choose how the 
+   * elements are stored:
+   * - @b PQUEUE_BINARY - a binary heap, in a single array (@b Heap).
+   * Same as @b PQUEUEinit().
+   * - @b PQUEUE_PAIRING - a pairing heap (@b PairHeap), with one
+   * allocated node per element. Insertion - and @b PQUEUEmeld() - take
+   * O(1) time. Extraction takes O(log n) amortized time, but is slower
+   * than for the binary heap in practice. A good choice for queues
+   * that are melded often - e.g. per-thread queues, merged at the end.
+   * - @b PQUEUE_RADIX - a radix heap (@b RadixHeap), for @a monotone
+   * workloads with unsigned integer keys - such as event timestamps, 
+   * or distances in Dijkstra's algorithm. The element of the
+   * @a smallest key comes out first - and no key inserted may be smaller
+   * than the key of the element extracted last. No elements are
+   * compared at all - @a compare is not used, but @a key instead.
+   * Extraction may need memory - to gather the elements of the next
+   * smallest key. If it runs out of memory, @b PQUEUEextract() returns
+   * -2 - not -1, as for an empty queue - and leaves the queue as it
+   * was. @b PQUEUEpeek() never needs memory to succeed.
+   *
+   * The functions taking handles - @b PQUEUEinsert_handle(),
+   * @b PQUEUEreplace_handle(), @b PQUEUEpushpop_handle(),
+   * @b PQUEUEupdate() and @b PQUEUEremove() - are supported by the
+   * binary heap engine only.
+   * @param[in] compare - a reference to a user-defined compare
+   * function - see @b PQUEUEinit(). Not used by @b PQUEUE_RADIX - 
+   * may be NULL, then.
+   * @param[in] key - a reference to a user-defined function, returning
+   * the key of element @a data - for @b PQUEUE_RADIX. Not used by the
+   * other engines - may be NULL, then.
+   * @param[in] destroy - a reference to a user-defined function,
+   * reponsible for freeing @a element @a data - or NULL.
+   * @param[in] engine - @b PQUEUE_BINARY, @b PQUEUE_PAIRING or
+   * @b PQUEUE_RADIX.
+   * @return A reference - to a new, empty priority queue - if 
+   * dynamic memory allocation for the ADT was successful - or
+   * NULL otherwise (also returned for an unknown @a engine - or 
+   * @b PQUEUE_RADIX without a @a key function).
+   * @see PQUEUEinit()
+   **/
+  PQueue PQUEUEinit_ex(int (*compare)(const void *key1, const void* key2),
+                       unsigned long (*key)(const void *data),
+                       void (*destroy)(void *data),
+                       int engine);
+
+  /**
+   * Initiate the priority queue - with a d-ary heap engine
+   * 
+   * Works like @b PQUEUEinit() - but the heap storing the elements
+   * has @a arity children per node - see @b HEAPinit_ex(). A 4-ary or
+   * 8-ary heap is shallower than a binary one - and scans the children
+   * of a node within a cache line or two - so large queues extract
+   * faster. The engine is @b PQUEUE_BINARY - so all functions taking
+   * handles are supported.
+   * @param[in] compare - a reference to a user-defined compare
+   * function - see @b PQUEUEinit().
+   * @param[in] destroy - a reference to a user-defined function,
+   * reponsible for freeing @a element @a data - or NULL.
+   * @param[in] arity - the number of children per node - at least 2.
+   * Use 4 or 8 for large queues.
+   * @return A reference - to a new, empty priority queue - if 
+   * dynamic memory allocation for the ADT was successful - or
+   * NULL otherwise (also returned for an @a arity less than 2).
+   * @see PQUEUEinit(), HEAPinit_ex()
+   **/
+  PQueue PQUEUEinit_arity(int (*compare)(const void *key1, const void* key2), void (*destroy)(void *data), int arity);
+
   /**
    * Destroy the priority queue
    * 
@@ -96,10 +200,57 @@ extern "C" {
    * @param[in] data - a reference to data to be inserted into
    * the priority queue.
    * @return Value 0 - if insertion was succesful\n
+   *         Value 1 - if the key of @a data is smaller than the key
+   *         of the last element extracted - @b PQUEUE_RADIX only\n
    *         Value -1 - otherwise.
    **/
   int PQUEUEinsert(PQueue pq, const void *data);
   
+  /**
+   * Insert data into the priority queue - and get a handle to it
+   * 
+   * Works like @b PQUEUEinsert() - but passes back a @a handle to the
+   * new element, for use with @b PQUEUEupdate() and @b PQUEUEremove().
+   * The handle stays valid until the element is extracted or removed.
+   * See @b HEAPinsert_handle(). Supported by @b PQUEUE_BINARY only.
+   * @param[in] pq - a reference to current priority queue.
+   * @param[in] data - a reference to data to be inserted into
+   * the priority queue.
+   * @param[out] handle - a reference to an integer - set to the
+   * handle of the new element, upon return.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value -1 - otherwise.
+   **/
+  int PQUEUEinsert_handle(PQueue pq, const void *data, int *handle);
+
+  /**
+   * Restore the queue order - after the priority of an element has changed
+   * 
+   * Change the key data of the element - in place - and then call
+   * this function, with the handle of the element. Takes O(log n) time.
+   * @param[in] pq - a reference to current priority queue.
+   * @param[in] handle - the handle of the changed element.
+   * @return Value 0 - if the call was succesful\n
+   *         Value -1 - if the handle is not in use - or the engine
+   *         is not @b PQUEUE_BINARY.
+   **/
+  int PQUEUEupdate(PQueue pq, int handle);
+
+  /**
+   * Remove an arbitrary element from the priority queue
+   * 
+   * @param[in] pq - a reference to current priority queue.
+   * @param[in] handle - the handle of the element to be removed.
+   * @param[out] data - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful.
+   * @return Value 0 - if the call was succesful\n
+   *         Value -1 - if the handle is not in use - or the engine
+   *         is not @b PQUEUE_BINARY.
+   **/
+  int PQUEUEremove(PQueue pq, int handle, void **data);
+
   /**
    * Peek at the top-priority element in the queue
    * 
@@ -107,7 +258,7 @@ extern "C" {
    * queue.
    * 
    * @return A reference to the top-priority element
-   * of the current priority queue.
+   * of the current priority queue - or NULL, if the queue is empty.
    *
    **/
   const void *PQUEUEpeek(const PQueue pq);
@@ -132,9 +283,104 @@ extern "C" {
    * 
    * @return Value 0 --  if the call was OK - that is, element
    * removed.\n
-   *         Value -1 -- otherwise.
+   *         Value -1 -- if the queue is empty.\n
+   *         Value -2 -- if out of memory - @b PQUEUE_RADIX only, see
+   *         @b PQUEUEinit_ex(). The queue is left unchanged.
    **/
   int PQUEUEextract(PQueue pq, void **data);
+
+  /**
+   * Remove up to @a k top-priority elements from the priority queue
+   * 
+   * See @b HEAPextract_n().
+   * @param[in] pq - reference to current priority queue.
+   * @param[out] data - an array of (at least) @a k pointers. After
+   * the call, it holds references to the data of the removed elements
+   * - top-priority first.
+   * @param[in] k - the max. number of elements to remove.
+   * @return The number of elements removed - or -1 if @a k is negative.
+   * Fewer than @a k - and than the size of the queue - only if out of
+   * memory, see @b PQUEUEextract().
+   **/
+  int PQUEUEextract_n(PQueue pq, void **data, int k);
+
+  /**
+   * Replace the top-priority element of the priority queue - with new data
+   * 
+   * Costs a single sift-down pass - instead of one pass for extraction
+   * and one for insertion - with @b PQUEUE_BINARY. See @b HEAPreplace().
+   * The other engines extract - and insert.
+   * @param[in] pq - reference to current priority queue.
+   * @param[in] data - a reference to data to be inserted into
+   * the priority queue.
+   * @param[out] top - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the data of the (old) top-priority element - if the call was
+   * successful.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- if the queue was empty - or out of memory,
+   *         when inserting @a data.\n
+   *         Value -2 -- if out of memory, when extracting - see
+   *         @b PQUEUEextract(). The queue is left unchanged.
+   **/
+  int PQUEUEreplace(PQueue pq, const void *data, void **top);
+
+  /**
+   * Insert new data into the priority queue - and remove the top-priority element
+   * 
+   * See @b HEAPpushpop().
+   * @param[in] pq - reference to current priority queue.
+   * @param[in] data - a reference to data to be inserted into
+   * the priority queue.
+   * @param[out] top - reference to a pointer. After the call, 
+   * this referenced pointer has been redirected to point to
+   * the top-priority data - of the queue, and the new data.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- otherwise (out of memory).\n
+   *         Value -2 -- if out of memory, when extracting - see
+   *         @b PQUEUEextract(). Then @a data has been inserted, but
+   *         nothing extracted.
+   **/
+  int PQUEUEpushpop(PQueue pq, const void *data, void **top);
+
+  /**
+   * Replace the top-priority element of the priority queue - and get a handle to the new data
+   * 
+   * Works like @b PQUEUEreplace() - but passes back a @a handle to the
+   * new element, like @b PQUEUEinsert_handle(). See
+   * @b HEAPreplace_handle(). Supported by @b PQUEUE_BINARY only.
+   * @param[in] pq - reference to current priority queue.
+   * @param[in] data - a reference to data to be inserted into
+   * the priority queue.
+   * @param[out] top - reference to a pointer - redirected to the data
+   * of the (old) top-priority element, if the call was successful.
+   * @param[out] handle - a reference to an integer - set to the
+   * handle of the new element, upon return.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- otherwise (empty queue, out of memory - or an
+   *         engine other than @b PQUEUE_BINARY).
+   **/
+  int PQUEUEreplace_handle(PQueue pq, const void *data, void **top, int *handle);
+
+  /**
+   * Insert new data into the priority queue - remove the top-priority element - and get a handle to the new data
+   * 
+   * Works like @b PQUEUEpushpop() - but passes back a @a handle to the
+   * new element - or -1, if the new data is passed right back in
+   * @a top. See @b HEAPpushpop_handle(). Supported by @b PQUEUE_BINARY
+   * only.
+   * @param[in] pq - reference to current priority queue.
+   * @param[in] data - a reference to data to be inserted into
+   * the priority queue.
+   * @param[out] top - reference to a pointer - redirected to the
+   * top-priority data, of the queue and the new data.
+   * @param[out] handle - a reference to an integer - set to the
+   * handle of the new element - or -1, upon return.
+   * @return Value 0 --  if the call was OK.\n
+   *         Value -1 -- otherwise (out of memory - or an engine other
+   *         than @b PQUEUE_BINARY).
+   **/
+  int PQUEUEpushpop_handle(PQueue pq, const void *data, void **top, int *handle);
   
   /**
    * Get the number of elements in the priority queue
@@ -147,6 +393,88 @@ extern "C" {
    **/
   int PQUEUEsize(PQueue pq);
 
+  /**
+   * Insert an array of data into the priority queue - in linear time
+   * 
+   * Works like calling @b PQUEUEinsert() for each element of the array
+   * @a data - but in O(n) time, with a single memory allocation. The
+   * array stays owned by the caller. See @b HEAPbuild().
+   * @param[in] pq - a reference to the current priority queue.
+   * @param[in] data - an array of references to data to be inserted.
+   * @param[in] n - the number of elements of @a data.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise.
+   **/
+  int PQUEUEbuild(PQueue pq, void **data, int n);
+
+  /**
+   * Let an empty priority queue take over an array of data
+   * 
+   * Like @b PQUEUEbuild() - but the dynamically allocated array
+   * @a data is heapified in place, and owned by the priority queue
+   * from now on. See @b HEAPadopt(). The other engines than
+   * @b PQUEUE_BINARY insert the elements - and free the array.
+   * @param[in] pq - a reference to the current priority queue -
+   * which must be empty.
+   * @param[in] data - a dynamically allocated array of references to
+   * data.
+   * @param[in] n - the number of elements of @a data.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - if the priority queue was not empty.
+   **/
+  int PQUEUEadopt(PQueue pq, void **data, int n);
+
+  /**
+   * Reserve room for a number of elements in the priority queue
+   * 
+   * Makes room for @a capacity elements at once - so a priority queue
+   * staying within this size never allocates memory on insertion or
+   * extraction. See @b HEAPreserve(). Does nothing - for the other
+   * engines than @b PQUEUE_BINARY.
+   * @param[in] pq - a reference to the current priority queue.
+   * @param[in] capacity - the number of elements to make room for.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise (out of memory).
+   **/
+  int PQUEUEreserve(PQueue pq, int capacity);
+
+  /**
+   * Turn the priority queue into a bounded top-K queue - or back
+   * 
+   * Keeps the @a k elements of highest priority - of all elements
+   * ever inserted - in O(k) memory. Each rejected element costs a
+   * single comparison. Note that the @a lowest-priority element kept
+   * is extracted first. See @b HEAPsettopk(). Supported by
+   * @b PQUEUE_BINARY only.
+   * @param[in] pq - a reference to the current priority queue.
+   * @param[in] k - the max. number of elements to keep - or 0, to turn
+   * the queue back into an ordinary (unbounded) priority queue.
+   * @return Value 0 - if the call was successful.\n
+   *         Value -1 - otherwise.
+   **/
+  int PQUEUEsettopk(PQueue pq, int k);
+
+  /**
+   * Move all elements of one priority queue into another
+   * 
+   * All elements of @a pq2 are inserted into @a pq1 - and @a pq2 is
+   * left empty, but not destroyed. This takes O(1) time for
+   * @b PQUEUE_PAIRING - and linear time for the other engines (O(m log n)
+   * time for a small @a pq2, with @b PQUEUE_BINARY).
+   * Both queues must have the same engine - and the same @a compare 
+   * (or @a key) function. See @b HEAPmeld(), @b PAIRHEAPmeld() and 
+   * @b RADIXHEAPmeld().
+   * @param[in] pq1 - a reference to the priority queue to insert into.
+   * @param[in] pq2 - a reference to the priority queue to take the
+   * elements from.
+   * @return Value 0 - if the call was successful.\n
+   *         Value 1 - if a key of @a pq2 is smaller than the last
+   *         extracted key of @a pq1 - @b PQUEUE_RADIX only.\n
+   *         Value -1 - otherwise (different engines, out of memory - or
+   *         @a pq1 and @a pq2 is the same queue).
+   **/
+  int PQUEUEmeld(PQueue pq1, PQueue pq2);
+
   /**
    * Print data contents of the priority queue on screen
    * 
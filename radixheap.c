@@ -0,0 +1,360 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: radixheap.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 15:42:51 2026
+ * Version : 0.51
+ * ---
+ * Description: A radix heap ADT - for monotone, unsigned integer keys - written in ANSI C.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 RADIXHEAPextract() now returns -2 when out of memory - and RADIXHEAPpeek() never fails,
+ *        for a non-empty heap.
+ *
+ */
+
+/**
+ * @file radixheap.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "radixheap.h"
+#include "allocator.h"
+
+/**
+ * Macro for the number of buckets
+ *
+ * One bucket for keys equal to the last extracted key - and one
+ * for each bit position, where a key may differ from it.
+ **/
+#define RADIXHEAP_BUCKETS ((int)(sizeof(unsigned long) * CHAR_BIT) + 1)
+
+/**
+ * Macro for the smallest allocated capacity of a bucket
+ **/
+#define RADIXHEAP_MINCAPACITY 8
+
+struct RadixHeapEntry_ {
+  unsigned long key;
+  void          *data;
+};
+
+struct RadixHeapBucket_ {
+  int size;
+  int capacity;
+  struct RadixHeapEntry_ *entries;
+};
+
+struct RadixHeap_ {
+  int           size;
+  unsigned long last;   /* The last extracted key */
+  unsigned long (*key)(const void *data);
+  void          (*destroy)(void *data);
+  const Allocator *alloc;
+  struct RadixHeapBucket_ buckets[RADIXHEAP_BUCKETS];
+};
+
+/* STATIC FUNCTION DECLARATIONS */
+static int bucketof(unsigned long last, unsigned long key);
+static int reserve(RadixHeap rh, struct RadixHeapBucket_ *bucket, int n);
+static int refill(RadixHeap rh);
+
+
+/* --- PUBLIC FUNCTION DEFINITIONS --- */
+/* --- Function: RadixHeap RADIXHEAPinit(unsigned long (*key)(const void *data), void (*destroy)(void *data)) --- */
+RadixHeap RADIXHEAPinit(unsigned long (*key)(const void *data), void (*destroy)(void *data))
+{
+  RadixHeap rh;
+  const Allocator *alloc = ALLOCATORget();
+  int i;
+
+  if ((rh = (RadixHeap)ALLOCATOR_MALLOC(alloc, sizeof(struct RadixHeap_))) == NULL)
+    return NULL;
+
+  rh->size = 0;
+  rh->last = 0;
+  rh->key = key;
+  rh->destroy = destroy;
+  rh->alloc = alloc;
+
+  for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+      rh->buckets[i].size = 0;
+      rh->buckets[i].capacity = 0;
+      rh->buckets[i].entries = NULL;
+    }
+
+  return rh;
+}
+
+/* --- Function: void RADIXHEAPdestroy(RadixHeap rh) --- */
+void RADIXHEAPdestroy(RadixHeap rh)
+{
+  int i, j;
+
+  for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+      if (rh->destroy != NULL)
+        {
+          for (j = 0; j < rh->buckets[i].size; j++)
+            rh->destroy(rh->buckets[i].entries[j].data);
+        }
+
+      ALLOCATOR_FREE(rh->alloc, rh->buckets[i].entries);
+    }
+
+  ALLOCATOR_FREE(rh->alloc, rh);
+}
+
+/* --- Function: int RADIXHEAPinsert(RadixHeap rh, const void *data) --- */
+int RADIXHEAPinsert(RadixHeap rh, const void *data)
+{
+  struct RadixHeapBucket_ *bucket;
+  unsigned long key = rh->key(data);
+
+  /* Keys must never decrease - below the last extracted key */
+  if (key < rh->last)
+    return 1;
+
+  bucket = &rh->buckets[bucketof(rh->last, key)];
+
+  if (reserve(rh, bucket, 1) != 0)
+    return -1;
+
+  bucket->entries[bucket->size].key = key;
+  bucket->entries[bucket->size].data = (void *)data;
+  bucket->size++;
+  rh->size++;
+
+  return 0;
+}
+
+/* --- Function: const void *RADIXHEAPpeek(RadixHeap rh) --- */
+const void *RADIXHEAPpeek(RadixHeap rh)
+{
+  struct RadixHeapBucket_ *bucket = &rh->buckets[0];
+
+  struct RadixHeapBucket_ *from;
+  int i, j, min;
+
+  switch (refill(rh))
+    {
+    case 0:
+      return bucket->entries[bucket->size - 1].data;
+    case -1:
+      return NULL;
+    }
+
+  /* Out of memory - the smallest key is in the first non-empty bucket. Scan it */
+  for (i = 1; rh->buckets[i].size == 0; i++)
+    ;
+
+  from = &rh->buckets[i];
+
+  for (j = 1, min = 0; j < from->size; j++)
+    {
+      if (from->entries[j].key < from->entries[min].key)
+        min = j;
+    }
+
+  return from->entries[min].data;
+}
+
+/* --- Function: int RADIXHEAPextract(RadixHeap rh, void **data) --- */
+int RADIXHEAPextract(RadixHeap rh, void **data)
+{
+  struct RadixHeapBucket_ *bucket = &rh->buckets[0];
+  int retval;
+
+  if ((retval = refill(rh)) != 0)
+    return retval;
+
+  /* All elements of bucket 0 have the smallest key - take the last one */
+  *data = bucket->entries[--bucket->size].data;
+  rh->size--;
+
+  return 0;
+}
+
+/* --- Function: int RADIXHEAPmeld(RadixHeap rh1, RadixHeap rh2) --- */
+int RADIXHEAPmeld(RadixHeap rh1, RadixHeap rh2)
+{
+  int counts[RADIXHEAP_BUCKETS];
+  struct RadixHeapBucket_ *from, *to;
+  int i, j;
+
+  if (rh1 == rh2)
+    return -1;
+
+  for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    counts[i] = 0;
+
+  /* Check - and count - all keys before moving any element, so the move cannot fail */
+  for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+      from = &rh2->buckets[i];
+
+      for (j = 0; j < from->size; j++)
+        {
+          if (from->entries[j].key < rh1->last)
+            return 1;
+
+          counts[bucketof(rh1->last, from->entries[j].key)]++;
+        }
+    }
+
+  for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+      if (reserve(rh1, &rh1->buckets[i], counts[i]) != 0)
+        return -1;
+    }
+
+  for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+      from = &rh2->buckets[i];
+
+      for (j = 0; j < from->size; j++)
+        {
+          to = &rh1->buckets[bucketof(rh1->last, from->entries[j].key)];
+          to->entries[to->size++] = from->entries[j];
+        }
+
+      from->size = 0;
+    }
+
+  rh1->size += rh2->size;
+  rh2->size = 0;
+
+  return 0;
+}
+
+/* --- Function: int RADIXHEAPsize(RadixHeap rh) --- */
+int RADIXHEAPsize(RadixHeap rh)
+{
+  return rh->size;
+}
+
+/* --- Function: void RADIXHEAPprint(RadixHeap rh, void (*callback)(const void *data)) --- */
+void RADIXHEAPprint(RadixHeap rh, void (*callback)(const void *data))
+{
+  int i, j;
+
+  for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+    {
+      if (rh->buckets[i].size == 0)
+        continue;
+
+      printf("\nBucket #%02d: ", i);
+
+      for (j = 0; j < rh->buckets[i].size; j++)
+        callback(rh->buckets[i].entries[j].data);
+    }
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static int bucketof(unsigned long last, unsigned long key) --- */
+static int bucketof(unsigned long last, unsigned long key)
+{
+  unsigned long diff = key ^ last;
+  int bit;
+
+  if (diff == 0)
+    return 0;
+
+  /* 1 + the position of the highest bit, where the key differs from the last key */
+#if defined(__GNUC__)
+  bit = RADIXHEAP_BUCKETS - 1 - __builtin_clzl(diff);
+#else
+  for (bit = 0; diff != 0; diff >>= 1)
+    bit++;
+#endif
+
+  return bit;
+}
+
+/* --- Function: static int reserve(RadixHeap rh, struct RadixHeapBucket_ *bucket, int n) --- */
+static int reserve(RadixHeap rh, struct RadixHeapBucket_ *bucket, int n)
+{
+  struct RadixHeapEntry_ *entries;
+  int capacity;
+
+  if (bucket->size + n <= bucket->capacity)
+    return 0;
+
+  /* Grow geometrically - buckets are never shrunk, but reused as keys move on */
+  capacity = bucket->capacity < RADIXHEAP_MINCAPACITY ? RADIXHEAP_MINCAPACITY : 2 * bucket->capacity;
+
+  if (capacity < bucket->size + n)
+    capacity = bucket->size + n;
+
+  if ((entries = (struct RadixHeapEntry_ *)ALLOCATOR_REALLOC(rh->alloc, bucket->entries, capacity * sizeof(struct RadixHeapEntry_))) == NULL)
+    return -1;
+
+  bucket->entries = entries;
+  bucket->capacity = capacity;
+
+  return 0;
+}
+
+/* --- Function: static int refill(RadixHeap rh) --- */
+static int refill(RadixHeap rh)
+{
+  int counts[RADIXHEAP_BUCKETS];
+  struct RadixHeapBucket_ *from, *to;
+  unsigned long min;
+  int i, j;
+
+  /* Nothing to do - as long as there are elements of the last extracted key */
+  if (rh->buckets[0].size > 0)
+    return 0;
+
+  if (rh->size == 0)
+    return -1;
+
+  /* The smallest key is in the first non-empty bucket */
+  for (i = 1; rh->buckets[i].size == 0; i++)
+    ;
+
+  from = &rh->buckets[i];
+  min = from->entries[0].key;
+
+  for (j = 1; j < from->size; j++)
+    {
+      if (from->entries[j].key < min)
+        min = from->entries[j].key;
+    }
+
+  /* Relative to the new smallest key - all elements of the bucket belong in lower
+     buckets. Make room for them first, so no element is lost if memory runs out */
+  for (j = 0; j < i; j++)
+    counts[j] = 0;
+
+  for (j = 0; j < from->size; j++)
+    counts[bucketof(min, from->entries[j].key)]++;
+
+  for (j = 0; j < i; j++)
+    {
+      if (reserve(rh, &rh->buckets[j], counts[j]) != 0)
+        return -2;
+    }
+
+  rh->last = min;
+
+  for (j = 0; j < from->size; j++)
+    {
+      to = &rh->buckets[bucketof(min, from->entries[j].key)];
+      to->entries[to->size++] = from->entries[j];
+    }
+
+  from->size = 0;
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: radixheap.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 15:42:51 2026
+ * Version : 0.51
+ * ---
+ * Description: A radix heap ADT - for monotone, unsigned integer keys - written in ANSI C.
+ *
+ * Revision history - coming up below:
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 RADIXHEAPextract() now returns -2 when out of memory - and RADIXHEAPpeek() never fails,
+ *        for a non-empty heap.
+ *
+ */
+/**
+ * @file radixheap.h
+ **/
+
+#ifndef _RADIXHEAP_H_
+#define _RADIXHEAP_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Use a @b typedef - to hide the interior of @b RadixHeap_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct RadixHeap_ *RadixHeap;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Initiate the radix heap
+   *
+   * A radix heap is a @a monotone @a min-heap for unsigned integer
+   * keys - i.e. the element of the @a smallest key is extracted
+   * first, and no key inserted may be smaller than the key of the
+   * element extracted last. This is the case for e.g. event
+   * timestamps in a simulation - and tentative distances in
+   * Dijkstra's algorithm.
+   *
+   * The elements are kept in buckets - one per bit of the key, plus
+   * one. Bucket @a i holds the elements whose keys differ from the
+   * last extracted key - in bit @a i-1 at the highest. No elements
+   * are compared at insertion - and each element moves to a lower
+   * bucket at most once per bit of the key, before it is extracted.
+   * Bucket contents are contiguous arrays, with the key of each
+   * element cached - so @a key is called once per element only.
+   * @param[in] key - a reference to a user-defined function, that
+   * shall return the key of element @a data.
+   * @param[in] destroy - a reference to a user-defined function,
+   * reponsible for freeing @a element @a data, when the heap is
+   * destroyed. If @a destroy is set to NULL - then element data will
+   * be left untouched upon heap destruction.
+   * @return A reference - to a new, empty heap - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise. Take
+   * really good care of this return value, since it will be needed
+   * as a parameter in subsequent calls - to the majority of other
+   * heap functions in this function interface - i.e. a sort of
+   * "handle" to the heap.
+   * @see RADIXHEAPdestroy()
+   **/
+  RadixHeap RADIXHEAPinit(unsigned long (*key)(const void *data), void (*destroy)(void *data));
+
+  /**
+   * Destroy the radix heap
+   *
+   * All element data is handed over to @a destroy, if set by
+   * @b RADIXHEAPinit() - and the heap is freed.
+   * @param[in] rh - a reference to current heap.
+   * @return Nothing.
+   * @see RADIXHEAPinit()
+   **/
+  void RADIXHEAPdestroy(RadixHeap rh);
+
+  /**
+   * Insert data into the radix heap
+   *
+   * Takes O(1) amortized time.
+   * @param[in] rh - a reference to current heap.
+   * @param[in] data - a reference to data to be inserted into
+   * the heap.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value 1 - if the key of @a data is smaller than the
+   *         key of the last element extracted - or peeked at, see
+   *         @b RADIXHEAPpeek() - i.e. not monotone\n
+   *         Value -1 - otherwise (out of memory).
+   **/
+  int RADIXHEAPinsert(RadixHeap rh, const void *data);
+
+  /**
+   * Inspect the element of the smallest key in the radix heap
+   *
+   * The elements of the smallest key are gathered into a bucket of
+   * their own, if needed - so this call may have to allocate memory.
+   * If it runs out of memory - the element is found by a scan of the
+   * elements, instead. So a non-empty heap always gives an element.
+   * @param[in] rh - a reference to current heap.
+   * @return A reference to the element of the smallest key - or
+   * NULL if the heap is empty.
+   **/
+  const void *RADIXHEAPpeek(RadixHeap rh);
+
+  /**
+   * Remove the element of the smallest key from the radix heap
+   *
+   * Elements of equal keys are extracted in no particular order.
+   * @param[in] rh - reference to current heap.
+   * @param[out] data - reference to a pointer. After the call,
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful. The caller is responsible for the future of
+   * this memory - deallocating it, for example.
+   * @return Value 0 --  if the call was OK - that is, element
+   * removed.\n
+   *         Value -1 -- if the heap is empty.\n
+   *         Value -2 -- if out of memory - when gathering the elements
+   *         of the smallest key. The heap is left unchanged.
+   **/
+  int RADIXHEAPextract(RadixHeap rh, void **data);
+
+  /**
+   * Move all elements of one radix heap into another
+   *
+   * @a rh2 is left empty, but not destroyed. Both heaps must have
+   * the same @a key function - and no key of @a rh2 may be smaller
+   * than the last extracted key of @a rh1.
+   * @param[in] rh1 - a reference to the heap to insert into.
+   * @param[in] rh2 - a reference to the heap to take the elements
+   * from.
+   * @return Value 0 - if the call was successful.\n
+   *         Value 1 - if a key of @a rh2 is smaller than the last
+   *         extracted key of @a rh1.\n
+   *         Value -1 - otherwise (out of memory - or @a rh1 and
+   *         @a rh2 is the same heap). Both heaps are left untouched,
+   *         on failure.
+   **/
+  int RADIXHEAPmeld(RadixHeap rh1, RadixHeap rh2);
+
+  /**
+   * Get the size of the radix heap
+   *
+   * @param[in] rh - a reference to the current heap.
+   * @return The size, that is, the number of elements
+   * in the heap.
+   **/
+  int RADIXHEAPsize(RadixHeap rh);
+
+  /**
+   * Print all data of the radix heap on screen - bucket by bucket
+   *
+   * @param[in] rh - reference to current heap.
+   * @param[in] callback - reference to user-defined callback function,
+   * that gets @b read @b access to element data via its parameter
+   * @a data - to do whatever is relevant.
+   * @return Nothing.
+   **/
+  void RADIXHEAPprint(RadixHeap rh, void (*callback)(const void *data));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RADIXHEAP_H_ */
@@ -16,6 +16,7 @@
  * Date   Revision message
  * 130413 Created this file
  * 150331 This code ready for version 0.51
+ * 261017 SETsort() is now stable - and runs in O(n log n) time, see SLISTsort().
  *
  */
 /**
@@ -217,6 +218,8 @@ extern "C" {
   
   /**
    * Sort a set
+   *
+   * The sort is stable - see @b SLISTsort().
    * 
    * @param[in] set - reference to current set.
    * @param[in] cmp - reference to a user-defined callback function 
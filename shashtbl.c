@@ -0,0 +1,469 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: shashtbl.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 10:12:31 2026
+ * Version : 0.51
+ * ---
+ * Description: An open-addressed, SIMD-probed ("Swiss") hashtable implemented as a pure,
+ *              generic ADT - written in ANSI C
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Memory is now allocated through the allocator of the library - see ALLOCATORset().
+ *
+ */
+/**
+ * @file shashtbl.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "shashtbl.h"
+#include "allocator.h"
+
+/* Use SSE2 for the group scans - unless told not to, or not available */
+#if !defined(SHTBL_NO_SSE2) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SHTBL_SSE2
+#include <emmintrin.h>
+#endif
+
+/* Number of positions scanned in parallel - one group of control tags */
+#define SHTBL_GROUP 16
+
+/* Control tag values - a full position holds 7 bits of the hash (0..127) instead */
+#define SHTBL_EMPTY   ((signed char)-128)
+#define SHTBL_DELETED ((signed char)-2)
+
+/* Max. load factor - 7/8 */
+#define SHTBL_MAXLOAD(capacity) ((capacity) - (capacity) / 8)
+
+struct SHtbl_
+{
+  int         capacity;   /* A power of 2 - and at least SHTBL_GROUP */
+  int         growth_left; /* Number of empty positions left to fill, before growing */
+
+  int         (*h)(const void *key);
+  int         (*match)(const void *key1, const void *key2);
+  void        (*destroy)(void *data);
+
+  int         size;
+  signed char *ctrl;      /* capacity + SHTBL_GROUP tags - the 1st group is mirrored at the end */
+  void        **slots;
+  const Allocator *alloc;
+};
+
+/* STATIC FUNCTION DECLARATIONS */
+static unsigned int mix(int hashval);
+static unsigned int match_tag(const signed char *group, signed char tag);
+static unsigned int match_empty(const signed char *group);
+static unsigned int match_free(const signed char *group);
+static int lowest_bit(unsigned int mask);
+static int highest_bit(unsigned int mask);
+static void set_ctrl(SHtbl htbl, int position, signed char tag);
+static int find(SHtbl htbl, const void *key, unsigned int hash);
+static int find_free(SHtbl htbl, unsigned int hash);
+static int alloc_table(SHtbl htbl, int capacity);
+static int resize(SHtbl htbl, int capacity);
+
+/* FUNCTION DEFINITIONS */
+
+SHtbl SHTBLinit(int positions, int (*h)(const void *key),
+                int (*match)(const void *key1, const void *key2), void (*destroy)(void *data))
+{
+  SHtbl htbl;
+  const Allocator *alloc = ALLOCATORget();
+  int capacity;
+
+  /* Allocate space for the hash table header */
+  if ((htbl = ALLOCATOR_MALLOC(alloc, sizeof(struct SHtbl_))) == NULL)
+    return NULL;
+
+  htbl->alloc = alloc;
+
+  /* Smallest power of 2 - holding 'positions' elements at max. load */
+  for (capacity = SHTBL_GROUP; SHTBL_MAXLOAD(capacity) < positions; capacity *= 2)
+    ;
+
+  if (alloc_table(htbl, capacity) != 0)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl);
+      return NULL;
+    }
+
+  /* Encapsulate the functions */
+  htbl->h = h;
+  htbl->match = match;
+  htbl->destroy = destroy;
+
+  /* Initialize the number of elements in the table */
+  htbl->size = 0;
+
+  return htbl;
+}
+
+void SHTBLdestroy(SHtbl htbl)
+{
+  int i;
+
+  if (htbl->destroy != NULL)
+    {
+      /* Call a user-defined function to free dynamically allocated data */
+      for (i = 0; i < htbl->capacity; i++)
+        {
+          if (htbl->ctrl[i] >= 0)
+            htbl->destroy(htbl->slots[i]);
+        }
+    }
+
+  /* Free the storage allocated for the hash table */
+  ALLOCATOR_FREE(htbl->alloc, htbl->ctrl);
+  ALLOCATOR_FREE(htbl->alloc, htbl->slots);
+
+  /* Free the storage allocated for the table header */
+  ALLOCATOR_FREE(htbl->alloc, htbl);
+}
+
+int SHTBLinsert(SHtbl htbl, const void *data)
+{
+  unsigned int hash;
+  int position;
+
+  /* Hash the key - once */
+  hash = mix(htbl->h(data));
+
+  /* Do nothing if the data is already in the table */
+  if (find(htbl, data, hash) >= 0) /* Duplicate found! */
+    return 1;
+
+  position = find_free(htbl, hash);
+
+  /* Reusing a deleted position is always fine - filling an empty one may need a resize */
+  if (htbl->ctrl[position] == SHTBL_EMPTY && htbl->growth_left == 0)
+    {
+      /* Mostly deleted positions - rehash at the current size. Otherwise - grow */
+      if (resize(htbl, htbl->size < SHTBL_MAXLOAD(htbl->capacity) / 2 ? htbl->capacity : 2 * htbl->capacity) != 0)
+        return -1;
+
+      position = find_free(htbl, hash);
+    }
+
+  if (htbl->ctrl[position] == SHTBL_EMPTY)
+    htbl->growth_left--;
+
+  set_ctrl(htbl, position, (signed char)(hash & 0x7f));
+  htbl->slots[position] = (void *)data;
+  htbl->size++;
+
+  return 0;
+}
+
+int SHTBLremove(SHtbl htbl, void **data)
+{
+  int position, before;
+  unsigned int empty_after, empty_before;
+
+  if ((position = find(htbl, *data, mix(htbl->h(*data)))) < 0)
+    {
+      /* Return that the data was not found */
+      return -1;
+    }
+
+  /* Pass back the data from the table */
+  *data = htbl->slots[position];
+  htbl->size--;
+
+  /* If no group-wide window around this position was ever full, no probe
+     sequence can have passed it - so it can be marked as empty again */
+  before = (position - SHTBL_GROUP) & (htbl->capacity - 1);
+  empty_after = match_empty(&htbl->ctrl[position]);
+  empty_before = match_empty(&htbl->ctrl[before]);
+
+  if (empty_after && empty_before &&
+      (SHTBL_GROUP - 1 - highest_bit(empty_before)) + lowest_bit(empty_after) < SHTBL_GROUP)
+    {
+      set_ctrl(htbl, position, SHTBL_EMPTY);
+      htbl->growth_left++;
+    }
+  else
+    set_ctrl(htbl, position, SHTBL_DELETED);
+
+  return 0;
+}
+
+int SHTBLlookup(const SHtbl htbl, void **data)
+{
+  int position;
+
+  if ((position = find(htbl, *data, mix(htbl->h(*data)))) < 0)
+    {
+      /* Return that the data was not found */
+      return -1;
+    }
+
+  /* Pass back the data from the table */
+  *data = htbl->slots[position];
+  return 0;
+}
+
+int SHTBLsize(SHtbl htbl)
+{
+  return htbl->size;
+}
+
+void SHTBLprint(SHtbl htbl, void (*callback)(const void *data))
+{
+  int i;
+
+  for (i=0; i<htbl->capacity; i++)
+    {
+      if (htbl->ctrl[i] == SHTBL_EMPTY)
+        printf("\nEMPTY");
+      else if (htbl->ctrl[i] == SHTBL_DELETED)
+        printf("\nDELETED");
+      else
+        callback(htbl->slots[i]);
+    }
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static unsigned int mix(int hashval) --- */
+static unsigned int mix(int hashval)
+{
+  unsigned int hash = (unsigned int)hashval;
+
+  /* Spread all bits of the user-defined hash value - over all bits (murmur3 finalizer) */
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bU;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35U;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+
+#ifdef SHTBL_SSE2
+/* --- Function: static unsigned int match_tag(const signed char *group, signed char tag) --- */
+static unsigned int match_tag(const signed char *group, signed char tag)
+{
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+
+  return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag)));
+}
+
+/* --- Function: static unsigned int match_empty(const signed char *group) --- */
+static unsigned int match_empty(const signed char *group)
+{
+  return match_tag(group, SHTBL_EMPTY);
+}
+
+/* --- Function: static unsigned int match_free(const signed char *group) --- */
+static unsigned int match_free(const signed char *group)
+{
+  /* Empty and deleted tags are the negative ones - i.e. have the sign bit set */
+  return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+#else
+/* --- Function: static unsigned int match_tag(const signed char *group, signed char tag) --- */
+static unsigned int match_tag(const signed char *group, signed char tag)
+{
+  unsigned int mask = 0;
+  int i;
+
+  for (i = 0; i < SHTBL_GROUP; i++)
+    {
+      if (group[i] == tag)
+        mask |= 1U << i;
+    }
+
+  return mask;
+}
+
+/* --- Function: static unsigned int match_empty(const signed char *group) --- */
+static unsigned int match_empty(const signed char *group)
+{
+  return match_tag(group, SHTBL_EMPTY);
+}
+
+/* --- Function: static unsigned int match_free(const signed char *group) --- */
+static unsigned int match_free(const signed char *group)
+{
+  unsigned int mask = 0;
+  int i;
+
+  for (i = 0; i < SHTBL_GROUP; i++)
+    {
+      if (group[i] < 0)
+        mask |= 1U << i;
+    }
+
+  return mask;
+}
+#endif
+
+/* --- Function: static int lowest_bit(unsigned int mask) --- */
+static int lowest_bit(unsigned int mask)
+{
+#if defined(__GNUC__)
+  return __builtin_ctz(mask);
+#else
+  int i = 0;
+
+  while (!(mask & 1U))
+    {
+      mask >>= 1;
+      i++;
+    }
+  return i;
+#endif
+}
+
+/* --- Function: static int highest_bit(unsigned int mask) --- */
+static int highest_bit(unsigned int mask)
+{
+#if defined(__GNUC__)
+  return 31 - __builtin_clz(mask);
+#else
+  int i = -1;
+
+  while (mask)
+    {
+      mask >>= 1;
+      i++;
+    }
+  return i;
+#endif
+}
+
+/* --- Function: static void set_ctrl(SHtbl htbl, int position, signed char tag) --- */
+static void set_ctrl(SHtbl htbl, int position, signed char tag)
+{
+  htbl->ctrl[position] = tag;
+
+  /* Keep the mirrored copy of the 1st group up to date - so a group starting
+     near the end of the table can be loaded without wrapping around */
+  if (position < SHTBL_GROUP)
+    htbl->ctrl[htbl->capacity + position] = tag;
+}
+
+/* --- Function: static int find(SHtbl htbl, const void *key, unsigned int hash) --- */
+static int find(SHtbl htbl, const void *key, unsigned int hash)
+{
+  unsigned int mask, bits;
+  int position, stride, i;
+  signed char tag;
+
+  mask = (unsigned int)htbl->capacity - 1;
+  tag = (signed char)(hash & 0x7f);
+  position = (int)((hash >> 7) & mask);
+
+  /* Triangular probing - over groups - visits every group of a power-of-2 table */
+  for (stride = SHTBL_GROUP; ; stride += SHTBL_GROUP)
+    {
+      /* Only positions with an agreeing tag need a closer look */
+      bits = match_tag(&htbl->ctrl[position], tag);
+
+      while (bits)
+        {
+          i = (position + lowest_bit(bits)) & (int)mask;
+
+          if (htbl->match(htbl->slots[i], key))
+            return i;
+
+          bits &= bits - 1;
+        }
+
+      /* An empty position in the group - the key would have been inserted here.. */
+      if (match_empty(&htbl->ctrl[position]))
+        return -1;
+
+      /* The whole table has been visited */
+      if (stride > htbl->capacity)
+        return -1;
+
+      position = (position + stride) & (int)mask;
+    }
+}
+
+/* --- Function: static int find_free(SHtbl htbl, unsigned int hash) --- */
+static int find_free(SHtbl htbl, unsigned int hash)
+{
+  unsigned int mask, bits;
+  int position, stride;
+
+  mask = (unsigned int)htbl->capacity - 1;
+  position = (int)((hash >> 7) & mask);
+
+  /* There is always an empty or deleted position - at a max. load of 7/8 */
+  for (stride = SHTBL_GROUP; ; stride += SHTBL_GROUP)
+    {
+      if ((bits = match_free(&htbl->ctrl[position])) != 0)
+        return (position + lowest_bit(bits)) & (int)mask;
+
+      position = (position + stride) & (int)mask;
+    }
+}
+
+/* --- Function: static int alloc_table(SHtbl htbl, int capacity) --- */
+static int alloc_table(SHtbl htbl, int capacity)
+{
+  if ((htbl->ctrl = (signed char *)ALLOCATOR_MALLOC(htbl->alloc, capacity + SHTBL_GROUP)) == NULL)
+    return -1;
+
+  if ((htbl->slots = (void **)ALLOCATOR_MALLOC(htbl->alloc, capacity * sizeof(void *))) == NULL)
+    {
+      ALLOCATOR_FREE(htbl->alloc, htbl->ctrl);
+      return -1;
+    }
+
+  memset(htbl->ctrl, SHTBL_EMPTY, capacity + SHTBL_GROUP);
+  htbl->capacity = capacity;
+  htbl->growth_left = SHTBL_MAXLOAD(capacity);
+
+  return 0;
+}
+
+/* --- Function: static int resize(SHtbl htbl, int capacity) --- */
+static int resize(SHtbl htbl, int capacity)
+{
+  signed char *oldctrl;
+  void **oldslots;
+  int oldcapacity, i, position;
+  unsigned int hash;
+
+  oldctrl = htbl->ctrl;
+  oldslots = htbl->slots;
+  oldcapacity = htbl->capacity;
+
+  if (alloc_table(htbl, capacity) != 0)
+    {
+      htbl->ctrl = oldctrl;
+      htbl->slots = oldslots;
+      return -1;
+    }
+
+  /* Reinsert all elements - deleted positions are purged */
+  for (i = 0; i < oldcapacity; i++)
+    {
+      if (oldctrl[i] < 0)
+        continue;
+
+      hash = mix(htbl->h(oldslots[i]));
+      position = find_free(htbl, hash);
+      set_ctrl(htbl, position, (signed char)(hash & 0x7f));
+      htbl->slots[position] = oldslots[i];
+    }
+
+  htbl->growth_left -= htbl->size;
+
+  ALLOCATOR_FREE(htbl->alloc, oldctrl);
+  ALLOCATOR_FREE(htbl->alloc, oldslots);
+
+  return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: shashtbl.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 10:12:31 2026
+ * Version : 0.51
+ * ---
+ * Description: An open-addressed, SIMD-probed ("Swiss") hashtable implemented as a pure,
+ *              generic ADT - written in ANSI C
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ *
+ */
+/**
+ * @file shashtbl.h
+ **/
+
+
+#ifndef _SHASHTBL_H_
+#define _SHASHTBL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Use a @b typedef - to hide the interior of @b SHtbl_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct SHtbl_ *SHtbl;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   * Initialize the SIMD-probed hash table
+   *
+   * This is an open-addressed table - like @b OHtbl - but with
+   * a separate array of 1-byte @a control @a tags, one per position.
+   * A control tag holds 7 bits of the hash value of the element at
+   * that position - or marks the position as empty or deleted.
+   * Probing is done 16 positions at a time, by comparing 16 control
+   * tags in parallel (using SSE2 instructions where available - or a
+   * portable, scalar fallback otherwise). Element data is only
+   * visited - and the @a match callback only called - for positions
+   * whose tag agrees with the key. The table grows automatically,
+   * at a load factor of 7/8.
+   *
+   * @param[in] positions - The number of elements you want the
+   * table to hold, without having to grow.
+   * @param[in] h - A reference to a user-defined hash function.
+   * This function returns the @a hash @a value of the @a key
+   * parameter - given to function @b h()  - when called. All 32 bits
+   * of the hash value are used - they are mixed internally, so a
+   * simple hash function will do.
+   * @param[in] match - A reference to a user-defined @a match
+   * function. This function shall return 1 - if @a key1 is equal
+   * to @a key2 - or 0 otherwise.
+   * @param[in] destroy - A reference to a user-defined function,
+   * reponsible for freeing @a element @a data, when the table is
+   * destroyed. If @a destroy is set to NULL - then element data will
+   * be left untouched upon table destruction.
+   * @return A reference - to a new, empty table - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise. Take
+   * really good care of this return value, since it will be needed
+   * as a parameter in subsequent calls - to the majority of other
+   * table functions in this function interface - i.e. a sort
+   * of "handle" to the table.
+   * @see SHTBLdestroy()
+   **/
+  SHtbl SHTBLinit(int positions, int (*h)(const void *key),
+                  int (*match)(const void *key1, const void *key2), void (*destroy)(void *data));
+
+  /**
+   * Destroy the hash table
+   *
+   * The table is destroyed - that is, all memory occupied by
+   * the elements - will be deallocated. The user-defined callback
+   * function @a destroy, given as an argument to @b SHTBLinit(), is
+   * responsible for freeing dynamically allocated element data, when
+   * this function is called. If @a destroy is set to NULL when
+   * @b SHTBLinit() is called, all data will be left untouched after
+   * the table is dismounted and destroyed. When all elements and data
+   * have been deallocated - the rest of the table is freed, too.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @return Nothing.
+   * @see SHTBLinit()
+   **/
+  void SHTBLdestroy(SHtbl htbl);
+
+  /**
+   * Insert a data element into the table
+   *
+   * Inserts an element into the current hash table - referenced by
+   * the parameter @a htbl. The data to be inserted, is referenced by
+   * parameter @a data. It is the responsability of the caller to
+   * ensure, that this memory is valid as long as it is present in the
+   * table. When the table grows, the hash function is called once
+   * per element in the table.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in] data - a reference to data to be inserted into
+   * the table.
+   * @return Value 0 - if insertion was succesful\n
+   *         Value 1 - if the element is already present in the table\n
+   *         Value -1 - otherwise (implies fatal error).
+   **/
+  int SHTBLinsert(SHtbl htbl, const void *data);
+
+  /**
+   * Remove a data element from the table
+   *
+   * When called, the 2nd parameter of this function, @a data,
+   * should reference an (external, user-defined) pointer, that
+   * points to the search key data.
+   * After the call - this referenced, external pointer has been
+   * redirected by this function, to point to the data of the
+   * removed element - if the call was succesful. The caller is
+   * responsible for the future  of this memory - deallocating it,
+   * if needed, for example.
+   *
+   * @param[in] htbl - reference to current table.
+   * @param[in,out] data - reference to a pointer. After the call,
+   * this referenced pointer has been redirected to point to
+   * the data of the removed element - if the call was
+   * successful. The caller is responsible for the future of
+   * this memory - deallocating it, for example.
+   *
+   * @return Value 0 --  if the call was OK - that is, element
+   * found and removed.\n
+   *         Value -1 --  node not found.\n
+   **/
+  int SHTBLremove(SHtbl htbl, void **data);
+
+  /**
+   * Determine if a data element exists in the table
+   *
+   * Determines whether an element, with key data matching
+   * the data referenced by the parameter @a data - is
+   * present in the current table @a htbl. This 2nd parameter,
+   * @a data, should reference an (external, user-defined)
+   * pointer, that points to the search key data.
+   * After the call - this referenced, external pointer has been
+   * redirected by this function, to point to the data of the
+   * element hit - if the call was succesful.
+   *
+   * @param[in] htbl - a reference to current table.
+   * @param[in,out] data - a reference to a pointer, pointing at
+   * the data to be searched for - at the call. Upon return - this
+   * pointer has been redirected by this function - and points
+   * instead to data in the element hit - if any.
+   *
+   * @return Value 0 - if element with matching data was found.\n
+   *         Value -1 - otherwise.
+   **/
+  int SHTBLlookup(const SHtbl htbl, void **data);
+
+  /**
+   * Get the size of the table
+   *
+   * @param[in] htbl - a reference to the current table.
+   *
+   * @return The size, that is, the number of elements
+   * in the table.
+   **/
+  int SHTBLsize(SHtbl htbl);
+
+  /**
+   * Print all data of the hash table - on screen
+   *
+   * @param[in] htbl - reference to current table.
+   * @param[in] callback - reference to user-defined callback function,
+   * that gets @b read @b access to element data via its parameter
+   * @a data - to do whatever is relevant. In this case it is a matter
+   * of formatting data for printing on screen. The printed data
+   * should be kept to a minimum (the key value, for example) in order
+   * not to clutter the screen. This function is primarily for small
+   * tables and debugging purposes.
+   *
+   * @return - Nothing.
+   **/
+  void SHTBLprint(SHtbl htbl, void (*callback)(const void *data));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SHASHTBL_H_ */
@@ -22,6 +22,11 @@
  * 2013-02-19  Made some revision to the Doxygen documentation. Enhanced the description of
  *             in/out parameters - i.e. double-pointers.             
  * 2015-03-31  This code ready for version 0.51
+ * 2026-10-17  SLISTsort() now sorts in O(n log n) time - with HEAPsort(), on an array of the node data.
+ * 2026-10-17  Added SLISTinit_pool() - nodes may now be allocated from a NodePool.
+ * 2026-10-17  Added SLISTinit_alloc() - memory is now allocated through an allocator, see ALLOCATORset().
+ * 2026-10-17  SLISTsort() is now a stable merge sort - relinking the nodes, with O(1) extra memory.
+ * 2026-10-17  SLISTreverse() and backward traversal are now iterative - no recursion, per node.
  */
 
 /**
@@ -30,6 +35,22 @@
  **/
 
 #include "slist.h"
+#include "allocator.h"
+
+/**
+ * Macro for the max. size of a list - sorted by insertion sort
+ *
+ * Longer lists are merge sorted, by SLISTsort().
+ **/
+#define SLIST_SORT_THRESHOLD 8
+
+/**
+ * Macro for the number of nodes per chunk - when traversing backwards
+ *
+ * SLISTtraverse() marks the first node of each chunk, in a forward pass
+ * - and then buffers the nodes of one chunk at a time, backwards.
+ **/
+#define SLIST_BWD_CHUNK 256
 
 struct SListElmt_
 {
@@ -44,19 +65,34 @@ struct SList_
   void                (*destroy)(void *data);
   struct SListElmt_    *head;
   struct SListElmt_    *tail;
+  NodePool            pool;      /* Node pool - or NULL, for the allocator */
+  int                 ownpool;   /* Set - if the pool belongs to the list */
+  const Allocator     *alloc;    /* Allocator - of the list header and nodes */
 };
 
 
 static void revert(SlistNode node);
-static void bwd_traverse(SlistNode node, void (*callback)(const void *data));
+static void bwd_traverse(Slist list, void (*callback)(const void *data));
+static void insert_sort(Slist list, int (*cmp)(const void *key1, const void *key2));
+static void merge_sort(Slist list, int (*cmp)(const void *key1, const void *key2));
+static SlistNode new_node(Slist list);
+static void free_node(Slist list, SlistNode node);
 
 /* FUNCTION DEFINITIONS --------------------------------------------------- */
 
 Slist SLISTinit(void (*destroy)(void *data))
+{
+  return SLISTinit_alloc(destroy, ALLOCATORget());
+}
+
+Slist SLISTinit_alloc(void (*destroy)(void *data), const Allocator *alloc)
 {
   Slist list;
 
-  if ((list = (Slist)malloc(sizeof(struct SList_)))==NULL)
+  if (alloc == NULL)
+    alloc = ALLOCATORget();
+
+  if ((list = (Slist)ALLOCATOR_MALLOC(alloc, sizeof(struct SList_)))==NULL)
     return NULL;
 
   list->size = 0;
@@ -64,6 +100,31 @@ Slist SLISTinit(void (*destroy)(void *data))
   list->destroy = destroy;
   list->head = NULL;
   list->tail = NULL;
+  list->pool = NULL;
+  list->ownpool = 0;
+  list->alloc = alloc;
+
+  return list;
+}
+
+Slist SLISTinit_pool(void (*destroy)(void *data), NodePool pool)
+{
+  Slist list;
+  NodePool own = NULL;
+
+  /* A private pool - unless a shared one is given */
+  if (pool == NULL && (pool = own = NODEPOOLinit(sizeof(struct SListElmt_), 0)) == NULL)
+    return NULL;
+
+  if (NODEPOOLfit(pool, sizeof(struct SListElmt_)) != 0 || (list = SLISTinit(destroy)) == NULL)
+    {
+      if (own != NULL)
+        NODEPOOLdestroy(own);
+      return NULL;
+    }
+
+  list->pool = pool;
+  list->ownpool = own != NULL;
 
   return list;
 }
@@ -79,14 +140,18 @@ void SLISTdestroy(Slist list)
           NULL) 
         list->destroy(data);
     }
-  free(list);
+
+  if (list->ownpool)
+    NODEPOOLdestroy(list->pool);
+
+  ALLOCATOR_FREE(list->alloc, list);
 }
 
 int SLISTinsnext(Slist list, SlistNode node, const void *data)
 {
   SlistNode newelement;
 
-  if ((newelement = (SlistNode)malloc(sizeof(struct SListElmt_))) == NULL)
+  if ((newelement = new_node(list)) == NULL)
     return -1;
 
   newelement->data = (void *)data;
@@ -144,7 +209,7 @@ int SLISTremnext(Slist list, SlistNode node, void **data)
         list->tail = node;
     }
 
-  free(oldelement);
+  free_node(list, oldelement);
 
   list->size--;
 
@@ -248,7 +313,6 @@ void SLISTreverse(Slist list)
     {
       /* Call 'revert()' to reverse the list physically */
       revert(list->head);
-      list->head->next = NULL;
 
       /* Swap head- and tailpointers */
       tmp = list->head;
@@ -259,53 +323,162 @@ void SLISTreverse(Slist list)
 
 static void revert(SlistNode node)
 {
-  if (!(node->next))
-    return;
+  SlistNode prev = NULL, next;
 
-  revert(node->next);
-  node->next->next=node;
+  /* Turn the links around - node by node, without recursion */
+  while (node != NULL)
+    {
+      next = node->next;
+      node->next = prev;
+      prev = node;
+      node = next;
+    }
 }
 
-/* Selection sort for linked list */
 void SLISTsort(Slist list, int (*cmp)(const void *key1, const void *key2))
 {
-  SlistNode curr, maxmin, tmp;
-  void *tmpdata;
+  if (list->size < 2)
+    return;
 
-  if (list->size > 1)
+  /* Few nodes - an insertion sort. Otherwise - a merge sort */
+  if (list->size <= SLIST_SORT_THRESHOLD)
+    insert_sort(list, cmp);
+  else
+    merge_sort(list, cmp);
+}
+
+static void insert_sort(Slist list, int (*cmp)(const void *key1, const void *key2))
+{
+  SlistNode node, next, pos;
+  SlistNode sorted = NULL;
+
+  /* Relink the nodes one by one - each one after all sorted nodes not greater (=stable) */
+  for (node = list->head; node != NULL; node = next)
     {
-      curr = list->head;
+      next = node->next;
 
-      while (curr->next)
+      if (sorted == NULL || cmp(node->data, sorted->data) < 0)
         {
-          maxmin = curr;
-          tmp = curr->next;
+          node->next = sorted;
+          sorted = node;
+          continue;
+        }
 
-          while(tmp)
-            {
-              if (cmp(tmp->data, maxmin->data) < 0)
-                maxmin = tmp;
-              tmp = tmp->next;
-            }
+      for (pos = sorted; pos->next != NULL && cmp(pos->next->data, node->data) <= 0; pos = pos->next)
+        ;
+
+      node->next = pos->next;
+      pos->next = node;
+    }
+
+  list->head = sorted;
 
-          if (maxmin != curr)
+  /* Find the tail */
+  for (node = list->head; node->next != NULL; node = node->next)
+    ;
+
+  list->tail = node;
+}
+
+static void merge_sort(Slist list, int (*cmp)(const void *key1, const void *key2))
+{
+  SlistNode p, q, node, head, tail;
+  int size, psize, qsize, merges;
+
+  /* Bottom-up - merge runs of 1, 2, 4.. nodes, pairwise, until a single run is left */
+  head = list->head;
+
+  for (size = 1; ; size *= 2)
+    {
+      p = head;
+      head = tail = NULL;
+      merges = 0;
+
+      while (p != NULL)
+        {
+          merges++;
+
+          /* The 2nd run starts 'size' nodes after the 1st - or is empty */
+          for (q = p, psize = 0; psize < size && q != NULL; psize++)
+            q = q->next;
+
+          qsize = size;
+
+          /* Merge the runs - taking from the 1st one, when equal (=stable) */
+          while (psize > 0 || (qsize > 0 && q != NULL))
             {
-              tmpdata = curr->data;
-              curr->data = maxmin->data;
-              maxmin->data = tmpdata;
+              if (psize > 0 && (qsize == 0 || q == NULL || cmp(p->data, q->data) <= 0))
+                {
+                  node = p;
+                  p = p->next;
+                  psize--;
+                }
+              else
+                {
+                  node = q;
+                  q = q->next;
+                  qsize--;
+                }
+
+              if (tail != NULL)
+                tail->next = node;
+              else
+                head = node;
+
+              tail = node;
             }
-          curr = curr->next;
+
+          p = q;
         }
+
+      tail->next = NULL;
+
+      if (merges <= 1)
+        break;
     }
+
+  list->head = head;
+  list->tail = tail;
 }
 
-static void bwd_traverse(SlistNode node, void (*callback)(const void *data))
+
+static void bwd_traverse(Slist list, void (*callback)(const void *data))
 {
-  if (!(node))
-    return;
+  SlistNode curr, *marks, *chunk;
+  int nmarks, i, j;
 
-  bwd_traverse(node->next, callback);
-  callback(node->data);
+  nmarks = (list->size + SLIST_BWD_CHUNK - 1) / SLIST_BWD_CHUNK;
+
+  /* Out of memory - reverse the list temporarily, traverse it and reverse it back */
+  if ((marks = (SlistNode *)ALLOCATOR_MALLOC(list->alloc, (nmarks + SLIST_BWD_CHUNK) * sizeof(SlistNode))) == NULL)
+    {
+      revert(list->head);
+
+      for (curr = list->tail; curr != NULL; curr = curr->next)
+        callback(curr->data);
+
+      revert(list->tail);
+      return;
+    }
+
+  chunk = marks + nmarks;
+
+  /* Mark the first node of each chunk... */
+  for (curr = list->head, i = 0; curr != NULL; curr = curr->next, i++)
+    if (i % SLIST_BWD_CHUNK == 0)
+      marks[i / SLIST_BWD_CHUNK] = curr;
+
+  /* ...and walk the chunks from the last one - each one backwards, from the buffer */
+  for (i = nmarks - 1; i >= 0; i--)
+    {
+      for (curr = marks[i], j = 0; j < SLIST_BWD_CHUNK && curr != NULL; curr = curr->next)
+        chunk[j++] = curr;
+
+      while (j > 0)
+        callback(chunk[--j]->data);
+    }
+
+  ALLOCATOR_FREE(list->alloc, marks);
 }
 
 void SLISTtraverse(Slist list, void (*callback)(const void *data), int direction)
@@ -316,9 +489,23 @@ void SLISTtraverse(Slist list, void (*callback)(const void *data), int direction
     for (curr=list->head; curr != NULL; curr=curr->next)
       callback(curr->data); 
 
-  if (direction == SLIST_BWD)
-    {
-      curr = list->head;
-      bwd_traverse(curr, callback);
-    }
+  if (direction == SLIST_BWD && list->size > 0)
+    bwd_traverse(list, callback);
+}
+
+static SlistNode new_node(Slist list)
+{
+  /* From the pool - when the list has one */
+  if (list->pool != NULL)
+    return (SlistNode)NODEPOOLalloc(list->pool);
+
+  return (SlistNode)ALLOCATOR_MALLOC(list->alloc, sizeof(struct SListElmt_));
+}
+
+static void free_node(Slist list, SlistNode node)
+{
+  if (list->pool != NULL)
+    NODEPOOLfree(list->pool, node);
+  else
+    ALLOCATOR_FREE(list->alloc, node);
 }
@@ -26,6 +26,11 @@
  *             the ADT header. The data type "match_callback" is the following typedef:
  *             typedef int (*match_callback)(const void *, const void *).
  * 2015-03-31  This code ready for version 0.51
+ * 2026-10-17  SLISTsort() now runs in O(n log n) time - see HEAPsort().
+ * 2026-10-17  Added SLISTinit_pool() - for lists with nodes from a node pool.
+ * 2026-10-17  Added SLISTinit_alloc() - lists now allocate memory through an allocator.
+ * 2026-10-17  SLISTsort() is now a stable merge sort - relinking the nodes, with O(1) extra memory.
+ * 2026-10-17  SLISTreverse() and backward traversal are now iterative - see SLISTtraverse().
  *
  */
 
@@ -42,6 +47,9 @@
 #include <malloc.h>
 #include <assert.h>
 
+#include "nodepool.h"
+#include "allocator.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -99,6 +107,40 @@ extern "C" {
    **/
   Slist SLISTinit(void (*destroy)(void *data));
 
+  /**
+   * Initiate the list - with an allocator of its own
+   *
+   * Works like @b SLISTinit() - but the list header and nodes are
+   * allocated by @a alloc - instead of the allocator of the library,
+   * see @b ALLOCATORset(). Handy for containers built on lists.
+   * @param[in] destroy - see @b SLISTinit().
+   * @param[in] alloc - a reference to the allocator - which must
+   * outlive the list - or NULL, for the allocator of the library.
+   * @return A reference - to a new, empty list - or NULL, if out of
+   * memory.
+   * @see SLISTinit(), ALLOCATORset()
+   **/
+  Slist SLISTinit_alloc(void (*destroy)(void *data), const Allocator *alloc);
+
+  /**
+   * Initiate the list - with nodes allocated from a node pool
+   *
+   * Works like @b SLISTinit() - but the nodes are taken from @a pool, and
+   * given back to it - instead of being allocated by @b malloc(),
+   * and freed, one by one. So insertion and removal are cheaper - and
+   * the nodes of the list lie close together in memory.
+   * @param[in] destroy - see @b SLISTinit().
+   * @param[in] pool - a reference to a node pool - see
+   * @b NODEPOOLinit(). The pool may be shared with other lists - and
+   * must outlive all of them. If @a pool is NULL - the list gets a
+   * pool of its own, destroyed with the list.
+   * @return A reference - to a new, empty list - or NULL, if out of
+   * memory - or if the nodes of the list do not fit in the blocks of
+   * @a pool.
+   * @see SLISTinit(), NODEPOOLinit()
+   **/
+  Slist SLISTinit_pool(void (*destroy)(void *data), NodePool pool);
+
   /**
    * Destroy the list. 
    * 
@@ -310,6 +352,9 @@ extern "C" {
 
   /**
    * Reverse the list - physically.
+   *
+   * The links are turned around in a single pass - in O(n) time and
+   * O(1) extra memory, without recursion.
    * 
    * @param[in] list - reference to current list.
    *
@@ -318,8 +363,14 @@ extern "C" {
   void SLISTreverse(Slist list);
 
   /**
-   * Sort a list according to the Selection Sort Algorithm -
-   * with complexity &Theta;(n<sup>2</sup>)).
+   * Sort a list - with merge sort, in O(n log n) time
+   *
+   * The nodes are relinked - in place, by a bottom-up (=non-recursive)
+   * merge sort - with O(1) extra memory, so the sort cannot fail. Short
+   * lists - of a few nodes only - are insertion sorted instead. Each
+   * node keeps its data - so references to nodes stay valid, but not
+   * their positions. The sort is stable - i.e. nodes with equal data
+   * keep their relative order.
    * 
    * @param[in] list - reference to current list.
    * @param[in] cmp - reference to a user-defined callback function 
@@ -345,6 +396,11 @@ extern "C" {
    * @a data - to do whatever is relevant. Print data, for example.
    * @param[in] direction - @a direction of @a traversal. Set to SLIST_FWD
    * for forward traversal - and SLIST_BWD for traversing backwards.
+   * Backward traversal is not recursive - it walks the list in chunks
+   * of nodes, buffered one chunk at a time - with O(n) time, and extra
+   * memory for about n/256 + 256 node references. If that memory
+   * cannot be allocated, the list is reversed temporarily, instead -
+   * and the callback must then not access the list.
    *
    * @return Nothing.
    **/
@@ -0,0 +1,279 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: typedheap.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 17:05:12 2026
+ * Version : 0.51
+ * ---
+ * Description: A macro - generating heaps with keys of a given type, and inline key
+ *              comparison - written in ANSI C. Header only.
+ *
+ * Revision history - coming up below:
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ *
+ */
+/**
+ * @file typedheap.h
+ **/
+
+#ifndef _TYPEDHEAP_H_
+#define _TYPEDHEAP_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Macro for declaring the generated functions
+ *
+ * They are static - and inline, where the compiler supports it - so
+ * a heap may be defined in several translation units, and unused
+ * functions cause no warnings.
+ **/
+#if defined(__GNUC__)
+#define LEVAWC_INLINE static __inline__
+#elif defined(_MSC_VER)
+#define LEVAWC_INLINE static __inline
+#else
+#define LEVAWC_INLINE static
+#endif
+
+/**
+ * Macro for the number of children per node - of generated heaps
+ *
+ * A node - key and data reference - takes 16 bytes on a 64-bit
+ * machine, so 4 siblings share a cache line. Define it before
+ * including this file - to override.
+ **/
+#ifndef LEVAWC_HEAP_ARITY
+#define LEVAWC_HEAP_ARITY 4
+#endif
+
+/**
+ * Macro for the smallest allocated capacity - of generated heaps
+ **/
+#define LEVAWC_HEAP_MINCAPACITY 16
+
+/**
+ * Macros for ordering keys - for use as @a less in @b LEVAWC_DEFINE_HEAP()
+ *
+ * @b LEVAWC_LESS gives a min-heap - the element of the smallest key
+ * on top. @b LEVAWC_GREATER gives a max-heap.
+ **/
+#define LEVAWC_LESS(a, b) ((a) < (b))
+#define LEVAWC_GREATER(a, b) ((a) > (b))
+
+/**
+ * Macro generating a heap - with keys of type @a keytype
+ *
+ * Works like a @b Heap - but every node holds a key of its own,
+ * next to the data reference. The keys are compared by @a less - a
+ * macro or function, expanded inline - so there is neither a call
+ * through a function pointer, nor a dereference of element data,
+ * per comparison. The node of the top-priority key is kept at the
+ * top - i.e. the key @a k for which @a less(@a k, @a other) holds,
+ * for all other keys.
+ *
+ * For @a name, the following are defined:
+ * - @b name - a reference to a heap (a pointer type).
+ * - @b name_init(destroy) - returns a new, empty heap - or NULL. The
+ * user-defined function @a destroy - or NULL - is called for the data
+ * of all remaining nodes, when the heap is destroyed.
+ * - @b name_destroy(hp) - destroys the heap.
+ * - @b name_insert(hp, key, data) - returns 0 - or -1 if out of memory.
+ * - @b name_extract(hp, &key, &data) - removes the top node, and passes
+ * back its key and data - returns 0 - or -1 if the heap is empty.
+ * Either reference may be NULL.
+ * - @b name_peek(hp, &key) - returns the data of the top node - and
+ * passes back its key, unless @a key is NULL - or returns NULL if the
+ * heap is empty.
+ * - @b name_size(hp) - returns the number of nodes.
+ * - @b name_reserve(hp, capacity) - makes room for @a capacity nodes,
+ * and never shrinks below it - returns 0 - or -1 if out of memory.
+ *
+ * Example - a min-heap of timers, with deadlines of type double:
+ * @code
+ * LEVAWC_DEFINE_HEAP(TimerHeap, double, LEVAWC_LESS)
+ *
+ * TimerHeap th = TimerHeap_init(free);
+ * TimerHeap_insert(th, 2.5, timer);
+ * TimerHeap_extract(th, &deadline, &data);
+ * @endcode
+ * @param name - the name of the heap type - and the prefix of its
+ * functions.
+ * @param keytype - the type of the keys - any type that can be
+ * assigned - e.g. double, or an unsigned integer type.
+ * @param less - a macro or function - taking two keys, and returning
+ * non-zero if the 1st key has the higher priority.
+ **/
+#define LEVAWC_DEFINE_HEAP(name, keytype, less)                                  \
+                                                                                 \
+  struct name##Node_ {                                                           \
+    keytype key;                                                                 \
+    void    *data;                                                               \
+  };                                                                             \
+                                                                                 \
+  struct name##_ {                                                               \
+    int   size;                                                                  \
+    int   capacity;                                                              \
+    int   reserved;                                                              \
+    void  (*destroy)(void *data);                                                \
+    struct name##Node_ *tree;                                                    \
+  };                                                                             \
+                                                                                 \
+  typedef struct name##_ *name;                                                  \
+                                                                                 \
+  LEVAWC_INLINE int name##_resize(name hp, int capacity)                         \
+  {                                                                              \
+    struct name##Node_ *tmp;                                                     \
+                                                                                 \
+    if ((tmp = (struct name##Node_ *)realloc(hp->tree, capacity * sizeof(struct name##Node_))) == NULL) \
+      return -1;                                                                 \
+                                                                                 \
+    hp->tree = tmp;                                                              \
+    hp->capacity = capacity;                                                     \
+                                                                                 \
+    return 0;                                                                    \
+  }                                                                              \
+                                                                                 \
+  LEVAWC_INLINE name name##_init(void (*destroy)(void *data))                    \
+  {                                                                              \
+    name hp;                                                                     \
+                                                                                 \
+    if ((hp = (name)malloc(sizeof(struct name##_))) == NULL)                     \
+      return NULL;                                                               \
+                                                                                 \
+    hp->size = 0;                                                                \
+    hp->capacity = 0;                                                            \
+    hp->reserved = 0;                                                            \
+    hp->destroy = destroy;                                                       \
+    hp->tree = NULL;                                                             \
+                                                                                 \
+    return hp;                                                                   \
+  }                                                                              \
+                                                                                 \
+  LEVAWC_INLINE void name##_destroy(name hp)                                     \
+  {                                                                              \
+    int i;                                                                       \
+                                                                                 \
+    if (hp->destroy != NULL)                                                     \
+      {                                                                          \
+        for (i = 0; i < hp->size; i++)                                           \
+          hp->destroy(hp->tree[i].data);                                         \
+      }                                                                          \
+                                                                                 \
+    free(hp->tree);                                                              \
+    free(hp);                                                                    \
+  }                                                                              \
+                                                                                 \
+  LEVAWC_INLINE int name##_insert(name hp, keytype key, const void *data)        \
+  {                                                                              \
+    int currpos, parentpos;                                                      \
+                                                                                 \
+    if (hp->size == hp->capacity)                                                \
+      {                                                                          \
+        if (name##_resize(hp, hp->capacity < LEVAWC_HEAP_MINCAPACITY ? LEVAWC_HEAP_MINCAPACITY : 2 * hp->capacity) != 0) \
+          return -1;                                                             \
+      }                                                                          \
+                                                                                 \
+    /* Move parents down into the "hole" - from the end of the heap upwards */   \
+    for (currpos = hp->size++; currpos > 0; currpos = parentpos)                 \
+      {                                                                          \
+        parentpos = (currpos - 1) / LEVAWC_HEAP_ARITY;                           \
+                                                                                 \
+        if (!(less(key, hp->tree[parentpos].key)))                               \
+          break;                                                                 \
+                                                                                 \
+        hp->tree[currpos] = hp->tree[parentpos];                                 \
+      }                                                                          \
+                                                                                 \
+    hp->tree[currpos].key = key;                                                 \
+    hp->tree[currpos].data = (void *)data;                                       \
+                                                                                 \
+    return 0;                                                                    \
+  }                                                                              \
+                                                                                 \
+  LEVAWC_INLINE int name##_extract(name hp, keytype *key, void **data)           \
+  {                                                                              \
+    struct name##Node_ last;                                                     \
+    int currpos, childpos, lastpos, tmppos, i, capacity;                         \
+                                                                                 \
+    if (hp->size == 0)                                                           \
+      return -1;                                                                 \
+                                                                                 \
+    if (key != NULL)                                                             \
+      *key = hp->tree[0].key;                                                    \
+                                                                                 \
+    if (data != NULL)                                                            \
+      *data = hp->tree[0].data;                                                  \
+                                                                                 \
+    last = hp->tree[--hp->size];                                                 \
+                                                                                 \
+    /* Move children up into the "hole" - until the right level for 'last' */   \
+    for (currpos = 0; (childpos = currpos * LEVAWC_HEAP_ARITY + 1) < hp->size; currpos = tmppos) \
+      {                                                                          \
+        lastpos = childpos + LEVAWC_HEAP_ARITY < hp->size ? childpos + LEVAWC_HEAP_ARITY : hp->size; \
+        tmppos = childpos;                                                       \
+                                                                                 \
+        for (i = childpos + 1; i < lastpos; i++)                                 \
+          {                                                                      \
+            if (less(hp->tree[i].key, hp->tree[tmppos].key))                     \
+              tmppos = i;                                                        \
+          }                                                                      \
+                                                                                 \
+        if (!(less(hp->tree[tmppos].key, last.key)))                             \
+          break;                                                                 \
+                                                                                 \
+        hp->tree[currpos] = hp->tree[tmppos];                                    \
+      }                                                                          \
+                                                                                 \
+    if (hp->size > 0)                                                            \
+      hp->tree[currpos] = last;                                                  \
+                                                                                 \
+    /* Shrink - when no more than a quarter is used. Failure is harmless */     \
+    if (hp->size <= hp->capacity / 4)                                            \
+      {                                                                          \
+        capacity = hp->capacity / 2;                                             \
+                                                                                 \
+        if (capacity < hp->reserved)                                             \
+          capacity = hp->reserved;                                               \
+                                                                                 \
+        if (capacity >= LEVAWC_HEAP_MINCAPACITY && capacity < hp->capacity)      \
+          name##_resize(hp, capacity);                                           \
+      }                                                                          \
+                                                                                 \
+    return 0;                                                                    \
+  }                                                                              \
+                                                                                 \
+  LEVAWC_INLINE const void *name##_peek(name hp, keytype *key)                   \
+  {                                                                              \
+    if (hp->size == 0)                                                           \
+      return NULL;                                                               \
+                                                                                 \
+    if (key != NULL)                                                             \
+      *key = hp->tree[0].key;                                                    \
+                                                                                 \
+    return hp->tree[0].data;                                                     \
+  }                                                                              \
+                                                                                 \
+  LEVAWC_INLINE int name##_size(name hp)                                         \
+  {                                                                              \
+    return hp->size;                                                             \
+  }                                                                              \
+                                                                                 \
+  LEVAWC_INLINE int name##_reserve(name hp, int capacity)                        \
+  {                                                                              \
+    hp->reserved = capacity;                                                     \
+                                                                                 \
+    if (capacity <= hp->capacity)                                                \
+      return 0;                                                                  \
+                                                                                 \
+    return name##_resize(hp, capacity);                                          \
+  }
+
+#endif /* _TYPEDHEAP_H_ */
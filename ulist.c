@@ -0,0 +1,399 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: ulist.c
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 20:12:31 2026
+ * Version : 0.51
+ * ---
+ * Description: An unrolled, doubly-linked list - implemented as a pure, generic ADT.
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Positions with an index outside their node are now rejected.
+ *
+ */
+
+/**
+ * @file ulist.c
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ulist.h"
+#include "allocator.h"
+
+/**
+ * Macro for the number of elements per node
+ *
+ * 32 data references - and the links - fill about four cache lines.
+ **/
+#define ULIST_CHUNK 32
+
+struct UListElmt_
+{
+  struct UListElmt_  *prev;
+  struct UListElmt_  *next;
+  int                count;                /* Elements in use - data[0..count-1] */
+  void               *data[ULIST_CHUNK];
+};
+
+struct UList_
+{
+  int                size;
+  int                (*match)(const void *key1, const void *key2);
+  void               (*destroy)(void *data);
+  struct UListElmt_  *head;
+  struct UListElmt_  *tail;
+  const Allocator    *alloc;    /* Allocator - of the list header and nodes */
+};
+
+/* True if the index of a position is within its node */
+#define INNODE(pos) ((pos).idx >= 0 && (pos).idx < (pos).node->count)
+
+/* STATIC FUNCTION DECLARATIONS */
+static UlistPos position(UlistNode node, int idx);
+static int insert(Ulist list, UlistNode node, int idx, const void *data);
+static void merge(Ulist list, UlistNode node);
+static UlistNode new_node(Ulist list, UlistNode prev);
+static void free_node(Ulist list, UlistNode node);
+
+
+/* --- PUBLIC FUNCTION DEFINITIONS --- */
+/* --- Function: Ulist ULISTinit(void (*destroy)(void *data)) --- */
+Ulist ULISTinit(void (*destroy)(void *data))
+{
+  Ulist list;
+  const Allocator *alloc = ALLOCATORget();
+
+  if ((list = (Ulist)ALLOCATOR_MALLOC(alloc, sizeof(struct UList_))) == NULL)
+    return NULL;
+
+  list->size = 0;
+  list->match = NULL;
+  list->destroy = destroy;
+  list->head = NULL;
+  list->tail = NULL;
+  list->alloc = alloc;
+
+  return list;
+}
+
+/* --- Function: void ULISTdestroy(Ulist list) --- */
+void ULISTdestroy(Ulist list)
+{
+  UlistNode node;
+  int i;
+
+  while ((node = list->head) != NULL)
+    {
+      if (list->destroy != NULL)
+        for (i = 0; i < node->count; i++)
+          list->destroy(node->data[i]);
+
+      free_node(list, node);
+    }
+
+  ALLOCATOR_FREE(list->alloc, list);
+}
+
+/* --- Function: int ULISTinsnext(Ulist list, UlistPos pos, const void *data) --- */
+int ULISTinsnext(Ulist list, UlistPos pos, const void *data)
+{
+  /* Past the ends - allowed for an empty list only */
+  if (pos.node == NULL)
+    {
+      if (list->size != 0 || new_node(list, NULL) == NULL)
+        return -1;
+
+      return insert(list, list->head, 0, data);
+    }
+
+  if (!INNODE(pos))
+    return -1;
+
+  return insert(list, pos.node, pos.idx + 1, data);
+}
+
+/* --- Function: int ULISTinsprev(Ulist list, UlistPos pos, const void *data) --- */
+int ULISTinsprev(Ulist list, UlistPos pos, const void *data)
+{
+  if (pos.node == NULL)
+    {
+      if (list->size != 0 || new_node(list, NULL) == NULL)
+        return -1;
+
+      return insert(list, list->head, 0, data);
+    }
+
+  if (!INNODE(pos))
+    return -1;
+
+  return insert(list, pos.node, pos.idx, data);
+}
+
+/* --- Function: int ULISTremove(Ulist list, UlistPos pos, void **data) --- */
+int ULISTremove(Ulist list, UlistPos pos, void **data)
+{
+  UlistNode node = pos.node;
+
+  if (node == NULL || list->size == 0 || !INNODE(pos))
+    return -1;
+
+  *data = node->data[pos.idx];
+
+  /* Close the gap - within the node */
+  memmove(node->data + pos.idx, node->data + pos.idx + 1, (node->count - pos.idx - 1) * sizeof(void *));
+  node->count--;
+  list->size--;
+
+  /* Free an empty node - or merge a sparse one with a neighbour */
+  if (node->count == 0)
+    free_node(list, node);
+  else if (node->next != NULL && node->count + node->next->count <= ULIST_CHUNK / 2)
+    merge(list, node);
+  else if (node->prev != NULL && node->prev->count + node->count <= ULIST_CHUNK / 2)
+    merge(list, node->prev);
+
+  return 0;
+}
+
+/* --- Function: int ULISTsize(Ulist list) --- */
+int ULISTsize(Ulist list)
+{
+  return list->size;
+}
+
+/* --- Function: UlistPos ULISThead(Ulist list) --- */
+UlistPos ULISThead(Ulist list)
+{
+  return position(list->head, 0);
+}
+
+/* --- Function: UlistPos ULISTtail(Ulist list) --- */
+UlistPos ULISTtail(Ulist list)
+{
+  return position(list->tail, list->tail != NULL ? list->tail->count - 1 : 0);
+}
+
+/* --- Function: int ULISTishead(Ulist list, UlistPos pos) --- */
+int ULISTishead(Ulist list, UlistPos pos)
+{
+  return pos.node != NULL && pos.node == list->head && pos.idx == 0 ? 1 : 0;
+}
+
+/* --- Function: int ULISTistail(Ulist list, UlistPos pos) --- */
+int ULISTistail(Ulist list, UlistPos pos)
+{
+  return pos.node != NULL && pos.node == list->tail && pos.idx == pos.node->count - 1 ? 1 : 0;
+}
+
+/* --- Function: void *ULISTdata(UlistPos pos) --- */
+void *ULISTdata(UlistPos pos)
+{
+  return pos.node->data[pos.idx];
+}
+
+/* --- Function: UlistPos ULISTnext(UlistPos pos) --- */
+UlistPos ULISTnext(UlistPos pos)
+{
+  if (pos.idx + 1 < pos.node->count)
+    return position(pos.node, pos.idx + 1);
+
+  return position(pos.node->next, 0);
+}
+
+/* --- Function: UlistPos ULISTprev(UlistPos pos) --- */
+UlistPos ULISTprev(UlistPos pos)
+{
+  if (pos.idx > 0)
+    return position(pos.node, pos.idx - 1);
+
+  return position(pos.node->prev, pos.node->prev != NULL ? pos.node->prev->count - 1 : 0);
+}
+
+/* --- Function: UlistPos ULISTfindnode(Ulist list, const void *data) --- */
+UlistPos ULISTfindnode(Ulist list, const void *data)
+{
+  UlistNode node;
+  int i;
+
+  /* If match callback not set */
+  if (list->match == NULL)
+    return position(NULL, 0);
+
+  /* Scan the data references of each node - they lie next to each other */
+  for (node = list->head; node != NULL; node = node->next)
+    for (i = 0; i < node->count; i++)
+      if (list->match(data, node->data[i]))
+        return position(node, i);
+
+  return position(NULL, 0);
+}
+
+/* --- Function: void ULISTsetmatch(Ulist list, int (*match)(const void *key1, const void *key2)) --- */
+void ULISTsetmatch(Ulist list, int (*match)(const void *key1, const void *key2))
+{
+  list->match = match;
+}
+
+/* --- Function: int ULISTfind_remove(Ulist list, void **data) --- */
+int ULISTfind_remove(Ulist list, void **data)
+{
+  UlistPos pos;
+
+  /* If match-callback not set */
+  if (list->match == NULL)
+    return -2;
+
+  /* Search list sequentially.. */
+  pos = ULISTfindnode(list, *data);
+
+  if (pos.node == NULL) /* Element not found */
+    return 1;
+
+  /* Perform the removal.. */
+  return ULISTremove(list, pos, data);
+}
+
+/* --- Function: void ULISTtraverse(Ulist list, void (*callback)(const void *data), int direction) --- */
+void ULISTtraverse(Ulist list, void (*callback)(const void *data), int direction)
+{
+  UlistNode node;
+  int i;
+
+  if (direction == ULIST_FWD)
+    for (node = list->head; node != NULL; node = node->next)
+      for (i = 0; i < node->count; i++)
+        callback(node->data[i]);
+
+  if (direction == ULIST_BWD)
+    for (node = list->tail; node != NULL; node = node->prev)
+      for (i = node->count - 1; i >= 0; i--)
+        callback(node->data[i]);
+}
+
+/* --- STATIC FUNCTION DEFINITIONS --- */
+/* --- Function: static UlistPos position(UlistNode node, int idx) --- */
+static UlistPos position(UlistNode node, int idx)
+{
+  UlistPos pos;
+
+  pos.node = node;
+  pos.idx = idx;
+
+  return pos;
+}
+
+/* --- Function: static int insert(Ulist list, UlistNode node, int idx, const void *data) --- */
+static int insert(Ulist list, UlistNode node, int idx, const void *data)
+{
+  UlistNode next;
+  int half = ULIST_CHUNK / 2;
+
+  /* A full node - make room, in a neighbour, a new node - or by splitting it */
+  if (node->count == ULIST_CHUNK)
+    {
+      if (idx == ULIST_CHUNK)
+        {
+          if (node->next != NULL && node->next->count < ULIST_CHUNK)
+            node = node->next;
+          else if ((node = new_node(list, node)) == NULL)
+            return -1;
+
+          idx = 0;
+        }
+      else if (idx == 0)
+        {
+          if (node->prev != NULL && node->prev->count < ULIST_CHUNK)
+            node = node->prev;
+          else if ((node = new_node(list, node->prev)) == NULL)
+            return -1;
+
+          idx = node->count;
+        }
+      else
+        {
+          if ((next = new_node(list, node)) == NULL)
+            return -1;
+
+          /* Move the upper half to the new node */
+          memcpy(next->data, node->data + half, (ULIST_CHUNK - half) * sizeof(void *));
+          next->count = ULIST_CHUNK - half;
+          node->count = half;
+
+          if (idx > half)
+            {
+              node = next;
+              idx -= half;
+            }
+        }
+    }
+
+  memmove(node->data + idx + 1, node->data + idx, (node->count - idx) * sizeof(void *));
+  node->data[idx] = (void *)data;
+  node->count++;
+  list->size++;
+
+  return 0;
+}
+
+/* --- Function: static void merge(Ulist list, UlistNode node) --- */
+static void merge(Ulist list, UlistNode node)
+{
+  UlistNode next = node->next;
+
+  /* Move all elements of the next node - to the end of this one */
+  memcpy(node->data + node->count, next->data, next->count * sizeof(void *));
+  node->count += next->count;
+
+  free_node(list, next);
+}
+
+/* --- Function: static UlistNode new_node(Ulist list, UlistNode prev) --- */
+static UlistNode new_node(Ulist list, UlistNode prev)
+{
+  UlistNode node;
+
+  if ((node = (UlistNode)ALLOCATOR_MALLOC(list->alloc, sizeof(struct UListElmt_))) == NULL)
+    return NULL;
+
+  /* Link the empty node - after 'prev', or first, if 'prev' is NULL */
+  node->count = 0;
+  node->prev = prev;
+  node->next = prev != NULL ? prev->next : list->head;
+
+  if (node->next != NULL)
+    node->next->prev = node;
+  else
+    list->tail = node;
+
+  if (prev != NULL)
+    prev->next = node;
+  else
+    list->head = node;
+
+  return node;
+}
+
+/* --- Function: static void free_node(Ulist list, UlistNode node) --- */
+static void free_node(Ulist list, UlistNode node)
+{
+  /* Unlink the node - and free it */
+  if (node->prev != NULL)
+    node->prev->next = node->next;
+  else
+    list->head = node->next;
+
+  if (node->next != NULL)
+    node->next->prev = node->prev;
+  else
+    list->tail = node->prev;
+
+  ALLOCATOR_FREE(list->alloc, node);
+}
@@ -0,0 +1,354 @@
+/*
+ *       _____
+ * ANSI / ___/
+ *     / /__  
+ *     \___/  
+ *
+ * Filename: ulist.h
+ * Author  : Dan Levin
+ * Date    : Sat Oct 17 20:12:31 2026
+ * Version : 0.51
+ * ---
+ * Description: An unrolled, doubly-linked list - implemented as a pure, generic ADT.
+ *
+ * Revision history - coming up below:
+ *
+ * Date   Revision message
+ * 261017 Created this file
+ * 261017 Positions are invalid after any change of the list - see UlistPos.
+ *
+ */
+/**
+ * @file ulist.h
+ **/
+
+#ifndef _ULIST_H_
+#define _ULIST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Macro for forward traversal of the list
+   *
+   **/
+#define ULIST_FWD 1
+  /**
+   * Macro for backward traversal of the list
+   *
+   **/
+#define ULIST_BWD -1
+
+  /**
+   * Use a @b typedef - to hide the interior of @b UList_ - in the
+   * implementation file. This is how @a data @a hiding can be done in C.
+   *
+   **/
+  typedef struct UList_ *Ulist;
+
+  /**
+   * Another @b typedef - for hiding the interior of @b UListElmt_  -
+   * in the implementation file.
+   *
+   * Each node holds an array of references to node data - not a single
+   * one, as the nodes of a @b Dlist. So a scan of the list reads the
+   * data references of many elements from each node - close together
+   * in memory - and spends little memory on links, per element.
+   **/
+  typedef struct UListElmt_ *UlistNode;
+
+  /**
+   * A position in the list - an element of a node
+   *
+   * Unlike the interior of the list, this @b struct is not hidden -
+   * since positions are passed and returned by value. A position with
+   * @a node set to NULL is past the ends of the list - it is returned
+   * by @b ULISTnext(), after the last element - by @b ULISTfindnode(),
+   * when nothing is found - and by @b ULISThead() and @b ULISTtail(),
+   * when the list is empty.
+   *
+   * Inserting or removing an element moves other elements - of the
+   * same node, or of a node split, merged or freed by the call. So
+   * @b every position is invalid, after any change of the list - take
+   * a new one, e.g. by @b ULISThead(), @b ULISTtail() or
+   * @b ULISTfindnode(). A position with an index outside its node is
+   * rejected by @b ULISTinsnext(), @b ULISTinsprev() and @b ULISTremove()
+   * - but a stale position may still refer to another element, or to
+   * a freed node.
+   **/
+  typedef struct UlistPos_
+  {
+    UlistNode node;    /* The node - or NULL, past the ends of the list */
+    int       idx;     /* The element - an index into the node */
+  } UlistPos;
+
+  /* FUNCTION DECLARATIONS */
+
+  /**
+   *
+   * Initiate the list.
+   *
+   * @param[in] destroy - A reference to a user-made function, reponsible
+   * for freeing element data, when the list is deleted. If @a destroy is
+   * NULL - then element data will be left untouched when the list is
+   * destroyed.
+   * @return A reference - to a new, empty list - if dynamic memory
+   * allocation for the ADT was successful - or NULL otherwise.
+   * Take really good care of this return value, since it will be needed
+   * as a parameter in subsequent calls - to the majority of other list
+   * handling functions in this function interface - i.e. a sort of
+   * "handle" to the list.
+   * @see ULISTdestroy()
+   **/
+  Ulist ULISTinit(void (*destroy)(void *data));
+
+  /**
+   * Destroy the list.
+   *
+   * The list is destroyed - that is, all the memory occupied by the nodes
+   * is deallocated. The user-defined callback function @a destroy, given
+   * as an argument to @b ULISTinit(), is responsible for freeing
+   * dynamically allocated element data, when this function is called.
+   * When all nodes and data have been deallocated - the list header is
+   * deallocated, too.
+   *
+   * @param[in] list - a reference to current list.
+   * @return Nothing.
+   * @see ULISTinit()
+   **/
+  void ULISTdestroy(Ulist list);
+
+  /**
+   * Insert a new element - @b after parameter @a pos.
+   *
+   * This function inserts a new element, with a reference to data
+   * given by parameter @a data - @b after the element at position
+   * @a pos - into @a list. If the list is empty - @a pos should be past
+   * the ends of the list - as returned by @b ULISTtail(), for example.
+   * So appending an element is done by:
+   * @code
+   * ULISTinsnext(list, ULISTtail(list), data);
+   * @endcode
+   * An element inserted after the last one of a full node - gets a new
+   * node of its own. So a list built by appending - or prepending, by
+   * @b ULISTinsprev() - has full nodes.
+   *
+   * @param[in] list - reference to current list
+   * @param[in] pos - the position after which the new element is to be
+   * inserted. Should be past the ends of the list - if the list is empty.
+   * @param[in] data - reference to data to be stored in the new element.
+   *
+   * @return Value 0 - if everything went OK - or value -1 otherwise
+   * (also for an index of @a pos outside its node).
+   **/
+  int ULISTinsnext(Ulist list, UlistPos pos, const void *data);
+
+  /**
+   * Insert a new element - @b before parameter @a pos.
+   *
+   * This function inserts a new element, with a reference to data
+   * given by parameter @a data - @b before the element at position
+   * @a pos - into @a list. If the list is empty - @a pos should be past
+   * the ends of the list - as returned by @b ULISThead(), for example.
+   *
+   * @param[in] list - reference to current list
+   * @param[in] pos - the position before which the new element is to be
+   * inserted. Should be past the ends of the list - if the list is empty.
+   * @param[in] data - reference to data to be stored in the new element.
+   *
+   * @return Value 0 - if everything went OK - or value -1 otherwise
+   * (also for an index of @a pos outside its node).
+   **/
+  int ULISTinsprev(Ulist list, UlistPos pos, const void *data);
+
+  /**
+   * Remove the element at position @a pos.
+   *
+   * After the call - an (external) pointer referenced by parameter
+   * @a data, has been redirected to point to data of the removed
+   * element - if the call was succesful. The caller is responsible
+   * for the future of this memory - deallocating it, if needed,
+   * for example.
+   *
+   * A node emptied by the call is freed - and a node with few elements
+   * left is merged with a neighbour, if their elements fit in one node.
+   *
+   * @param[in] list - reference to current list.
+   * @param[in] pos - the position of the element to be removed.
+   * @param[out] data - reference to a pointer, that will point to data
+   * of the removed element - after the call, if successful.
+   *
+   * @return Value 0 - if the call was OK - or value -1
+   * otherwise (also for an index of @a pos outside its node).
+   **/
+  int ULISTremove(Ulist list, UlistPos pos, void **data);
+
+  /**
+   * Get the list size.
+   *
+   * @param[in] list - a reference to the current list.
+   *
+   * @return The size, that is, the number of elements in the list.
+   **/
+  int ULISTsize(Ulist list);
+
+  /**
+   * Get the position of the first element of the list.
+   *
+   * @param[in] list - a reference to the current list.
+   * @return The position of the @b first element in the list - or a
+   * position past the ends of the list, if it is empty.
+   **/
+  UlistPos ULISThead(Ulist list);
+
+  /**
+   * Get the position of the last element of the list.
+   *
+   * @param[in] list - a reference to the current list.
+   * @return The position of the @b last element in the list - or a
+   * position past the ends of the list, if it is empty.
+   **/
+  UlistPos ULISTtail(Ulist list);
+
+  /**
+   * Determine if a certain position is the head of
+   * the list - or not.
+   *
+   * @param[in] list - a reference to the current list.
+   * @param[in] pos - the position to be tested.
+   * @return Value 1 - if @a pos indeed is the position of the first
+   * element of the list - or 0 otherwise.
+   **/
+  int ULISTishead(Ulist list, UlistPos pos);
+
+  /**
+   * Determine if a certain position is the tail
+   * of the list - or not.
+   *
+   * @param[in] list - a reference to the current list.
+   * @param[in] pos - the position to be tested.
+   * @return Value 1 - if @a pos indeed is the position of the last
+   * element of the list - or 0 otherwise.
+   **/
+  int ULISTistail(Ulist list, UlistPos pos);
+
+  /**
+   * Get a reference to data stored in an element.
+   *
+   * @param[in] pos - the position of the element.
+   * @return Generic reference to data - stored in the element at
+   * position @a pos.
+   **/
+  void *ULISTdata(UlistPos pos);
+
+  /**
+   * Get the position of the next element in the list.
+   *
+   * @param[in] pos - @b current position.
+   * @return The position of the @b next element - following
+   * position @a pos - in the list. Past the ends of the list - if
+   * @a pos is the last element.
+   **/
+  UlistPos ULISTnext(UlistPos pos);
+
+  /**
+   * Get the position of the previous element in the list.
+   *
+   * @param[in] pos - @b current position.
+   * @return The position of the @b previous element - directly
+   * prior to position @a pos - in the list. Past the ends of the
+   * list - if @a pos is the first element.
+   **/
+  UlistPos ULISTprev(UlistPos pos);
+
+  /**
+   * Find the first element - with data matching data referenced by
+   * parameter @a data.
+   *
+   * Search the list sequentially for an element, whose data matches
+   * the data referenced by parameter @a data. The position of the
+   * @b first match will be returned. A @b user-defined @b callback
+   * @b function, responsible for doing the @b matching of element
+   * data - with data referenced by parameter @a data - @b must exist
+   * for this function to work - otherwise nothing will be found -
+   * always. This user-supplied @b match-callback is set into the list
+   * with another function - ULISTsetmatch().
+   *
+   * @param[in] list - reference to the current list.
+   * @param[in] data - reference to the search key data.
+   *
+   * @return The position of the first element with a match to data
+   * referenced by parameter @a data - if found - a position past the
+   * ends of the list otherwise.
+   * @see ULISTsetmatch()
+   **/
+  UlistPos ULISTfindnode(Ulist list, const void *data);
+
+  /**
+   * Set a valid match callback function for sequentially searching
+   * the list
+   *
+   * @param[in] list - reference to current list.
+   * @param[in] match - a reference to a user-defined function that
+   * receives references to element data - and search key data - via
+   * its parameters @a key1 and @a key2 - and thereby can make
+   * the actual matching. This match-callback shall return 1 -
+   * in case of a hit - or 0 otherwise.
+   *
+   * @return Nothing.
+   **/
+  void ULISTsetmatch(Ulist list, int (*match)(const void *key1,
+                                              const void *key2));
+  /**
+   * Search - and remove an element - by using an in/out parameter.
+   *
+   * When called, the 2nd parameter of this function, @a data, should
+   * reference a pointer, that points to the search key data. Moreover,
+   * a @b user-defined @b callback @b function responsible for doing the
+   * @b matching of element data - and data referenced by parameter
+   * @a data - must exist for this function to work - otherwise -2 will
+   * be returned - always.
+   * This user-supplied @b match-callback is set into the list with a
+   * call to another function, ULISTsetmatch().
+   *
+   * @param[in] list - reference to current list.
+   * @param[in,out] data - reference to an external pointer, that
+   * initially shall point to the search key data - when this
+   * function is called. After the call, this referenced (external)
+   * pointer, has been redirected - to point to data of the removed
+   * element - if the call was successful. The caller is responsible
+   * for the future of this memory - deallocating it, for example.
+   *
+   * @return Value 0 --  if the call was OK - that is, element found and removed.\n
+   *         Value 1 --  element not found.\n
+   *         Value -2 -- if match-callback is not set.\n
+   *         Value -1 -- otherwise (implies fatal error).
+   *
+   * @see ULISTsetmatch()
+   **/
+  int ULISTfind_remove(Ulist list, void **data);
+
+  /**
+   * Traverse the list from the beginning or the end - and have
+   * a user-defined function called - for each element in the list.
+   *
+   * @param[in] list - reference to current list.
+   * @param[in] callback - reference to user-defined callback function,
+   * that gets @b read @b access to element data via its parameter
+   * @a data - to do whatever is relevant. Print data, for example.
+   * @param[in] direction - @a direction of @a traversal. Set to ULIST_FWD
+   * for forward traversal - and ULIST_BWD for traversing backwards.
+   *
+   * @return Nothing.
+   **/
+  void ULISTtraverse(Ulist list, void (*callback)(const void *data), int direction);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ULIST_H_ */